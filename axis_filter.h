@@ -0,0 +1,183 @@
+#ifndef JOYSTICK_AXIS_FILTER_H
+#define JOYSTICK_AXIS_FILTER_H
+
+#include <cmath>
+
+namespace joy {
+
+// 축 파이프라인 첫 단계(노이즈 제거) 필터 종류
+enum class FilterType {
+    Ema,               // 1차 지수 이동 평균 (lowpassFilter_Joy, 시정수 filterTau)
+    Butterworth,       // 2차 Butterworth 저역 통과 (Q = 1/√2, 차단 주파수 filterCutoffHz)
+    CriticallyDamped,  // 2차 임계 감쇠 저역 통과 (Q = 0.5, 오버슈트 없음, 극 주파수 filterCutoffHz)
+    OneEuro,           // 적응형 1차 필터: 스틱 속도에 따라 차단 주파수가 filterCutoffHz부터 올라감
+};
+
+// 2차 필터(BiquadBank)를 쓰는 종류인지
+inline bool isBiquadFilter(FilterType type) {
+    return type == FilterType::Butterworth || type == FilterType::CriticallyDamped;
+}
+
+constexpr double BUTTERWORTH_Q       = 0.70710678118654752;
+constexpr double CRITICALLY_DAMPED_Q = 0.5;
+
+// 2차 IIR(biquad) 계수. y = b0*x + z1, z1 = b1*x - a1*y + z2, z2 = b2*x - a2*y (전치 직접형 II)
+struct BiquadCoeffs {
+    double b0, b1, b2;
+    double a1, a2;
+};
+
+/**
+ * @brief makeLowpassBiquad
+ *
+ * 아날로그 2차 저역 통과 필터를 쌍선형 변환(주파수 prewarp)으로 이산화한 계수 (RBJ Audio EQ Cookbook).
+ * DC 이득이 1이므로 스틱을 한 방향으로 끝까지 밀면 출력도 끝까지 갑니다.
+ * 차단 주파수는 나이퀴스트(0.5 / dt)의 90%로 제한합니다.
+ *
+ * 차단 주파수가 샘플링 주파수보다 훨씬 낮으면 a1 ≈ -2, a2 ≈ 1에 가까워져 float로는 DC 이득이
+ * 틀어지므로 계수와 상태는 double로 둡니다.
+ *
+ * @param cutoffHz  차단(극) 주파수 (Hz)
+ * @param q         Q 값 (BUTTERWORTH_Q, CRITICALLY_DAMPED_Q)
+ * @param dt        샘플 간격 (초)
+ */
+inline BiquadCoeffs makeLowpassBiquad(double cutoffHz, double q, double dt) {
+    double nyquist = 0.5 / dt;
+    if (cutoffHz > 0.9 * nyquist) {
+        cutoffHz = 0.9 * nyquist;
+    }
+    double w0 = 2.0 * M_PI * cutoffHz * dt;
+    double cosW = std::cos(w0);
+    double alpha = std::sin(w0) / (2.0 * q);
+    double a0 = 1.0 + alpha;
+
+    BiquadCoeffs c;
+    c.b0 = (1.0 - cosW) * 0.5 / a0;
+    c.b1 = (1.0 - cosW) / a0;
+    c.b2 = c.b0;
+    c.a1 = -2.0 * cosW / a0;
+    c.a2 = (1.0 - alpha) / a0;
+    return c;
+}
+
+/**
+ * @brief BiquadBank
+ *
+ * 축 N개에 같은 계수의 2차 저역 통과 필터를 적용하는 필터 뱅크 (축마다 상태만 따로).
+ * 계수는 setup()에서 필터 종류, 차단 주파수, dt가 바뀔 때만 다시 계산하므로 고정 주기로 돌면
+ * 매 틱 비용은 축당 곱셈·덧셈 몇 번입니다. 집합체(aggregate)라서 = {}로 초기화할 수 있습니다.
+ */
+template <int N>
+struct BiquadBank {
+    BiquadCoeffs coeffs;
+    FilterType type;       // 계수를 만든 설정 (setup에서 비교)
+    float cutoffHz;
+    float dt;
+    bool  valid;           // coeffs가 위 설정으로 계산되어 있음
+    double z1[N];
+    double z2[N];
+
+    // 설정이 바뀌었으면 계수를 다시 계산. 다시 계산했으면 true
+    bool setup(FilterType filterType, float cutoff, float sampleDt) {
+        if (valid && filterType == type && cutoff == cutoffHz && sampleDt == dt) {
+            return false;
+        }
+        double q = filterType == FilterType::CriticallyDamped ? CRITICALLY_DAMPED_Q : BUTTERWORTH_Q;
+        coeffs = makeLowpassBiquad(cutoff, q, sampleDt);
+        type = filterType;
+        cutoffHz = cutoff;
+        dt = sampleDt;
+        valid = true;
+        return true;
+    }
+
+    // 입력이 value로 계속 유지되어 온 정상 상태로 채움 (출력 = value, 첫 틱 과도 현상 없음)
+    // setup() 뒤에 호출할 것
+    void prime(const float value[N]) {
+        for (int i = 0; i < N; ++i) {
+            double x = value[i];
+            z1[i] = x * (1.0 - coeffs.b0);
+            z2[i] = x * (coeffs.b2 - coeffs.a2);
+        }
+    }
+
+    void process(const float in[N], float out[N]) {
+        const BiquadCoeffs c = coeffs;
+        for (int i = 0; i < N; ++i) {
+            double x = in[i];
+            double y = c.b0 * x + z1[i];
+            z1[i] = c.b1 * x - c.a1 * y + z2[i];
+            z2[i] = c.b2 * x - c.a2 * y;
+            out[i] = static_cast<float>(y);
+        }
+    }
+};
+
+// 차단 주파수 cutoffHz인 1차 저역 통과(EMA)의 계수 (lowpassFilter_Joy의 alpha = dt / (tau + dt)와 같은 형태)
+inline double oneEuroAlpha(double cutoffHz, double dt) {
+    double tau = 1.0 / (2.0 * M_PI * cutoffHz);
+    return dt / (tau + dt);
+}
+
+/**
+ * @brief OneEuroBank
+ *
+ * 축마다 One-Euro 필터(Casiez et al., CHI 2012)를 적용하는 필터 뱅크.
+ * 직전 raw 입력과의 차이로 구한 속도를 따로 저역 통과(차단 주파수 derivCutoffHz)로 걸러 추정하고,
+ * 그 속도에 비례해 값 필터의 차단 주파수를 올립니다. 속도는 필터 출력이 아니라 raw 입력끼리 미분하므로
+ * 출력이 따라잡는 중인 지연 자체는 속도로 잡히지 않습니다.
+ *
+ *   cutoff = minCutoffHz + beta * |속도|        (속도 단위: 최대 스틱 폭(rawFullScale) / 초)
+ *
+ * 스틱을 가만히 두면 minCutoffHz의 강한 필터로 떨림을 없애고, 빠르게 튕기면 차단 주파수가 올라가
+ * 지연이 거의 없어집니다. EMA처럼 계수가 틱마다 바뀌므로 축마다 나눗셈이 한 번 있습니다.
+ * 집합체(aggregate)라서 = {}로 초기화할 수 있습니다.
+ */
+template <int N>
+struct OneEuroBank {
+    double value[N];       // 값 필터 출력 (raw 단위)
+    double prevRaw[N];     // 직전 틱 raw 입력 (속도 계산용)
+    double speed[N];       // 걸러진 속도 (raw 단위 / 초)
+
+    // 입력이 start로 멈춰 있던 상태로 채움
+    void prime(const float start[N]) {
+        for (int i = 0; i < N; ++i) {
+            value[i] = start[i];
+            prevRaw[i] = start[i];
+            speed[i] = 0.0;
+        }
+    }
+
+    /**
+     * @param in             이번 틱 raw 입력
+     * @param out            필터 출력 (raw 단위)
+     * @param dt             직전 틱 이후 경과 시간 (초)
+     * @param minCutoffHz    멈춰 있을 때의 차단 주파수
+     * @param beta           속도 1(최대 스틱 폭/초)당 올라가는 차단 주파수 (Hz)
+     * @param derivCutoffHz  속도 추정 필터의 차단 주파수
+     * @param rawFullScale   속도를 정규화할 raw 값 폭 (예: 32767)
+     */
+    void process(const float in[N], float out[N], float dt, float minCutoffHz, float beta, float derivCutoffHz,
+                 float rawFullScale) {
+        if (!(dt > 0.0f)) {
+            for (int i = 0; i < N; ++i) {
+                out[i] = static_cast<float>(value[i]);
+            }
+            return;
+        }
+        const double alphaD = oneEuroAlpha(derivCutoffHz, dt);
+        const double speedScale = beta / rawFullScale;
+        for (int i = 0; i < N; ++i) {
+            double x = in[i];
+            double rawSpeed = (x - prevRaw[i]) / dt;
+            prevRaw[i] = x;
+            speed[i] += alphaD * (rawSpeed - speed[i]);
+            double cutoff = minCutoffHz + speedScale * std::fabs(speed[i]);
+            value[i] += oneEuroAlpha(cutoff, dt) * (x - value[i]);
+            out[i] = static_cast<float>(value[i]);
+        }
+    }
+};
+
+}  // namespace joy
+#endif // JOYSTICK_AXIS_FILTER_H
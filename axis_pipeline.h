@@ -0,0 +1,127 @@
+#ifndef JOYSTICK_AXIS_PIPELINE_H
+#define JOYSTICK_AXIS_PIPELINE_H
+
+#include <cmath>
+
+#include "response_curve.h"
+
+namespace joy {
+
+/**
+ * 컴파일 타임 축 파이프라인 (CONFIG_FIXED_RATE_PIPELINE)
+ *
+ * 루프 주기와 필터/데드존/곡선/슬루 설정이 빌드 때 정해져 있으면 alpha = dt / (tau + dt),
+ * 데드존 범위, 슬루 maxDelta가 모두 상수입니다. 단계마다 정책(policy) 타입을 골라
+ * Pipeline<Filter, Deadzone, Curve, Slew>로 묶으면 계수는 constexpr로 접히고, 쓰지 않는 단계는
+ * 코드에서 사라지며, 틱마다 도는 경로는 분기 없는 한 줄짜리 인라인 커널이 됩니다.
+ *
+ * 정책의 상수는 K 타입의 static constexpr 멤버에서 읽습니다 (C++17은 float 템플릿 인자를 받지 않음).
+ *   K::dt, K::filterTau, K::deadZone, K::curveExpo, K::slewInitialMaxRate, K::slewRunningMaxRate,
+ *   K::rawMaxNeg, K::rawMaxPos
+ *
+ * 각 단계는 joystick.cpp의 단계 함수(lowpassFilter_Joy, normalizeAxisValue, shapeAxis, applySlewRate)와
+ * 같은 순서로 같은 float 연산을 하므로, 같은 설정이면 processAxesScalar와 비트 단위로 같습니다.
+ */
+
+// 루프 주기 Hz의 한 틱 dt. 루프가 쓰는 (1e9 / hz) ns → 초 변환과 같은 식이라 주기를 놓치지 않은 틱의 dt와 같은 값
+template <int Hz>
+constexpr float fixedTickDt() {
+    static_assert(Hz > 0, "loop rate must be positive");
+    return (1000000000LL / Hz) / 1000000000.0f;
+}
+
+// ── 1) 필터 ──
+// 호출 측이 이미 filtered에 걸러 둔 값을 그대로 씀 (2차 필터 / OneEuro 또는 필터 없음)
+struct NoLowpass {
+    static float apply(float filtered, float /*raw*/) { return filtered; }
+};
+
+// 1차 EMA (lowpassFilter_Joy)
+template <class K>
+struct EmaLowpass {
+    static constexpr float alpha = K::dt / (K::filterTau + K::dt);
+    static float apply(float previous, float raw) { return previous + alpha * (raw - previous); }
+};
+
+// ── 2) 데드존 (입력: 정규화된 값의 절대값) ──
+struct NoDeadzone {
+    static float apply(float absVal) { return absVal; }
+};
+
+// applyDeadzone과 같은 식. 1 - deadZone도 상수로 접힘
+template <class K>
+struct FixedDeadzone {
+    static constexpr float threshold = K::deadZone;
+    static constexpr float range = 1.0f - K::deadZone;
+    static_assert(threshold >= 0.0f && threshold < 1.0f, "deadzone must be in [0, 1)");
+    static float apply(float absVal) { return absVal < threshold ? 0.0f : (absVal - threshold) / range; }
+};
+
+// ── 3) 응답 곡선 (evalCurve<C>와 같은 식, Lut은 런타임 표가 필요해 지원하지 않음) ──
+template <CurveType C, class K>
+struct FixedCurve {
+    static_assert(C != CurveType::Lut, "Lut curve needs runtime data; use the generic pipeline");
+    static constexpr float expo = K::curveExpo;
+    static float apply(float x) {
+        if constexpr (C == CurveType::Linear) {
+            return x;
+        } else if constexpr (C == CurveType::Quadratic) {
+            return x * x;
+        } else if constexpr (C == CurveType::Cubic) {
+            return x * x * x;
+        } else {
+            return x * ((1.0f - expo) + expo * x * x);
+        }
+    }
+};
+
+// ── 4) 슬루율 제한 ──
+struct NoSlew {
+    static float apply(float /*previous*/, float desired, bool /*initialPhase*/) { return desired; }
+};
+
+// applySlewRate와 같은 식. 초기/안정 구간의 maxDelta = rate * dt를 미리 계산
+template <class K>
+struct FixedSlew {
+    static constexpr float initialMaxDelta = K::slewInitialMaxRate * K::dt;
+    static constexpr float runningMaxDelta = K::slewRunningMaxRate * K::dt;
+    static float apply(float previous, float desired, bool initialPhase) {
+        const float maxDelta = initialPhase ? initialMaxDelta : runningMaxDelta;
+        float diff = desired - previous;
+        if (diff > maxDelta) {
+            diff = maxDelta;
+        } else if (diff < -maxDelta) {
+            diff = -maxDelta;
+        }
+        return previous + diff;
+    }
+};
+
+/**
+ * @brief Pipeline
+ *
+ * 축 N개에 필터 → 정규화 → 데드존 → 곡선(부호 복원) → 슬루를 적용합니다.
+ * processAxesScalar와 인자 의미가 같고, 파라미터 구조체 대신 정책 타입이 상수를 들고 있습니다.
+ *
+ * @param raw           축 raw 값
+ * @param filtered      필터 상태 (입력: 직전 값 또는 이미 걸러진 값, 출력: 갱신된 값)
+ * @param out           축 출력 (입력: 직전 출력(슬루 기준), 출력: 새 출력)
+ * @param initialPhase  슬루 초기 구간(스위치 타임 이전)인지
+ */
+template <class Filter, class Deadzone, class Curve, class Slew, class K>
+struct Pipeline {
+    template <int N>
+    static inline void process(const float *raw, float *filtered, float *out, bool initialPhase) {
+        for (int i = 0; i < N; ++i) {
+            float f = Filter::apply(filtered[i], raw[i]);
+            filtered[i] = f;
+            float normalized = f < 0.0f ? f / K::rawMaxNeg : f / K::rawMaxPos;
+            float magnitude = Curve::apply(Deadzone::apply(std::fabs(normalized)));
+            float scaled = normalized >= 0 ? magnitude : -magnitude;
+            out[i] = Slew::apply(out[i], scaled, initialPhase);
+        }
+    }
+};
+
+}  // namespace joy
+#endif // JOYSTICK_AXIS_PIPELINE_H
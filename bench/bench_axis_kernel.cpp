@@ -0,0 +1,224 @@
+// 축 파이프라인 커널 검증 및 벤치마크: processAxesScalar vs processAxesBatch vs processAxesFixed
+//
+// 1) 검증: 무작위 raw 입력과 축별 곡선(Linear/Quadratic/Cubic/Expo/Lut) 조합으로
+//    두 구현을 같은 상태에서 반복 실행하며 출력과 필터 상태의 ULP 차이를 비교합니다.
+//    고정 파이프라인(processAxesFixed)은 CONFIG_* 값으로 만든 파라미터의 processAxesScalar와 비교합니다.
+//    MAX_ULP를 넘는 차이가 있으면 종료 코드 1로 끝납니다.
+// 2) 벤치마크: 8축 한 틱 처리 시간(ns/op)을 비교합니다. updateSharedState가 매 틱 하는 일(캐시한
+//    파라미터에 alpha/maxDelta만 덮어쓰고 processAxesBatch)과, 매 틱 makeAxisPipelineParams로
+//    파라미터를 다시 만드는 경우를 함께 잽니다.
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "joystick.h"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// 허용 ULP 차이. 기본 빌드(-std=c++17, ISO 모드라 FMA 축약 없음)에서는 비트 단위로 같아야 합니다.
+// -ffp-contract=fast나 -ffast-math로 빌드해 비교할 때만 -DBENCH_MAX_ULP=2 처럼 넓히세요.
+#ifndef BENCH_MAX_ULP
+#define BENCH_MAX_ULP 0
+#endif
+constexpr int64_t MAX_ULP = BENCH_MAX_ULP;
+
+int64_t orderedBits(float v) {
+    int32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits < 0 ? static_cast<int64_t>(INT32_MIN) - bits : bits;
+}
+
+int64_t ulpDiff(float a, float b) {
+    int64_t d = orderedBits(a) - orderedBits(b);
+    return d < 0 ? -d : d;
+}
+
+joy::AxisCurves randomCurves(std::mt19937 &rng) {
+    std::uniform_int_distribution<int> typeDist(0, 4);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    joy::AxisCurves curves;
+    for (int i = 0; i < joy::MAX_AXES; ++i) {
+        curves.axes[i] = joy::makeResponseCurve(static_cast<joy::CurveType>(typeDist(rng)), unit(rng));
+        float y = 0.0f;
+        for (int k = 0; k < joy::CURVE_LUT_POINTS; ++k) {
+            curves.axes[i].lut[k] = y;
+            y += unit(rng) / (joy::CURVE_LUT_POINTS - 1);
+        }
+    }
+    return curves;
+}
+
+// 검증: 반환값은 최대 ULP 차이. useLowpass가 false면 2차 필터 모드처럼 filtered에 걸러진 값을 직접 넣음
+int64_t verify(bool useSlew, bool useLowpass, int rounds, int ticksPerRound) {
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> rawDist(-32767.0f, 32767.0f);
+    std::uniform_real_distribution<float> dzDist(0.0f, 0.3f);
+    std::uniform_real_distribution<float> dtDist(0.0005f, 0.02f);
+
+    int64_t worst = 0;
+    for (int round = 0; round < rounds; ++round) {
+        joy::AxisCurves curves = randomCurves(rng);
+        float dz = dzDist(rng);
+        float filteredS[joy::MAX_AXES] = {}, outS[joy::MAX_AXES] = {};
+        float filteredB[joy::MAX_AXES] = {}, outB[joy::MAX_AXES] = {};
+
+        for (int tick = 0; tick < ticksPerRound; ++tick) {
+            float dt = dtDist(rng);
+            float alpha = dt / (CONFIG_FILTER_TAU + dt);
+            joy::AxisPipelineParams params =
+                joy::makeAxisPipelineParams(alpha, dz, CONFIG_SLEW_RUNNING_MAX_RATE * dt, useSlew, curves);
+            params.applyLowpass = useLowpass;
+
+            float raw[joy::MAX_AXES];
+            for (int i = 0; i < joy::MAX_AXES; ++i) {
+                raw[i] = static_cast<float>(static_cast<int>(rawDist(rng)));
+                if (!useLowpass) {
+                    filteredS[i] = filteredB[i] = rawDist(rng);
+                }
+            }
+            joy::processAxesScalar(raw, filteredS, outS, params);
+            joy::processAxesBatch(raw, filteredB, outB, params);
+
+            for (int i = 0; i < joy::MAX_AXES; ++i) {
+                int64_t d = ulpDiff(outS[i], outB[i]);
+                int64_t df = ulpDiff(filteredS[i], filteredB[i]);
+                if (d > worst) worst = d;
+                if (df > worst) worst = df;
+                if ((d > MAX_ULP || df > MAX_ULP) && worst == (d > df ? d : df)) {
+                    std::printf("  mismatch: axis %d curve %d scalar %.9g batch %.9g (%lld ulp)\n",
+                                i, static_cast<int>(curves.axes[i].type), outS[i], outB[i],
+                                static_cast<long long>(d > df ? d : df));
+                }
+            }
+        }
+    }
+    return worst;
+}
+
+// 고정 파이프라인 검증: 한 틱 dt = FIXED_PIPELINE_DT, CONFIG_* 값의 파라미터로 만든 processAxesScalar와 비교
+int64_t verifyFixed(int ticks) {
+    std::mt19937 rng(54321);
+    std::uniform_real_distribution<float> rawDist(-32767.0f, 32767.0f);
+    joy::JoystickConfig config = joy::defaultJoystickConfig("verify");
+    if (!joy::matchesFixedPipeline(config)) {
+        std::printf("  default config does not match the fixed pipeline\n");
+        return INT32_MAX;
+    }
+    const float dt = joy::FIXED_PIPELINE_DT;
+    const bool useEma = config.filterType == joy::FilterType::Ema;
+    float filteredS[joy::MAX_AXES] = {}, outS[joy::MAX_AXES] = {};
+    float filteredF[joy::MAX_AXES] = {}, outF[joy::MAX_AXES] = {};
+
+    int64_t worst = 0;
+    for (int tick = 0; tick < ticks; ++tick) {
+        bool initialPhase = tick < ticks / 4;
+        float maxRate = initialPhase ? config.slewInitialMaxRate : config.slewRunningMaxRate;
+        joy::AxisPipelineParams params = joy::makeAxisPipelineParams(
+            dt / (config.filterTau + dt), config.deadZone, maxRate * dt, config.useSlew, config.curves);
+        params.applyLowpass = useEma;
+
+        float raw[joy::MAX_AXES];
+        for (int i = 0; i < joy::MAX_AXES; ++i) {
+            raw[i] = static_cast<float>(static_cast<int>(rawDist(rng)));
+            if (!useEma) {
+                filteredS[i] = filteredF[i] = rawDist(rng);
+            }
+        }
+        joy::processAxesScalar(raw, filteredS, outS, params);
+        joy::processAxesFixed(raw, filteredF, outF, initialPhase);
+
+        for (int i = 0; i < joy::MAX_AXES; ++i) {
+            int64_t d = ulpDiff(outS[i], outF[i]);
+            int64_t df = ulpDiff(filteredS[i], filteredF[i]);
+            if (d > worst) worst = d;
+            if (df > worst) worst = df;
+        }
+    }
+    return worst;
+}
+
+template <typename Fn>
+double timeNsPerOp(Fn fn, int iterations) {
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iterations;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 10000000;
+
+    bool ok = true;
+    for (bool useLowpass : {true, false}) {
+        for (bool useSlew : {false, true}) {
+            int64_t worst = verify(useSlew, useLowpass, 200, 5000);
+            std::printf("verify slew=%d lowpass=%d: max diff %lld ulp %s\n", useSlew ? 1 : 0, useLowpass ? 1 : 0,
+                        static_cast<long long>(worst), worst <= MAX_ULP ? "OK" : "FAIL");
+            ok = ok && worst <= MAX_ULP;
+        }
+    }
+    int64_t worstFixed = verifyFixed(200 * 5000);
+    std::printf("verify fixed pipeline:    max diff %lld ulp %s\n", static_cast<long long>(worstFixed),
+                worstFixed <= MAX_ULP ? "OK" : "FAIL");
+    ok = ok && worstFixed <= MAX_ULP;
+
+    // 벤치마크: 기본 곡선(Quadratic), 슬루 사용
+    joy::AxisCurves curves;
+    for (int i = 0; i < joy::MAX_AXES; ++i) {
+        curves.axes[i] = joy::makeResponseCurve(CONFIG_RESPONSE_CURVE, CONFIG_CURVE_EXPO);
+    }
+    const float dt = 1.0f / CONFIG_JOYSTICK_HZ;
+    joy::AxisPipelineParams params = joy::makeAxisPipelineParams(
+        dt / (CONFIG_FILTER_TAU + dt), CONFIG_DEFAULT_DEADZONE, CONFIG_SLEW_RUNNING_MAX_RATE * dt, true, curves);
+
+    float raw[2][joy::MAX_AXES];
+    for (int i = 0; i < joy::MAX_AXES; ++i) {
+        raw[0][i] = (i % 2 ? -1.0f : 1.0f) * 30000.0f;
+        raw[1][i] = (i % 2 ? 1.0f : -1.0f) * 1000.0f;
+    }
+    float filtered[joy::MAX_AXES] = {}, out[joy::MAX_AXES] = {};
+
+    double scalarNs = timeNsPerOp([&](int i) {
+        joy::processAxesScalar(raw[(i >> 8) & 1], filtered, out, params);
+    }, iterations);
+    double batchNs = timeNsPerOp([&](int i) {
+        joy::processAxesBatch(raw[(i >> 8) & 1], filtered, out, params);
+    }, iterations);
+
+    joy::AxisPipelineParams cached = params;
+    double cachedBatchNs = timeNsPerOp([&](int i) {
+        cached.alpha = dt / (CONFIG_FILTER_TAU + dt);
+        cached.maxDelta = CONFIG_SLEW_RUNNING_MAX_RATE * dt;
+        joy::processAxesBatch(raw[(i >> 8) & 1], filtered, out, cached);
+    }, iterations);
+    double paramsBatchNs = timeNsPerOp([&](int i) {
+        joy::AxisPipelineParams tickParams = joy::makeAxisPipelineParams(
+            dt / (CONFIG_FILTER_TAU + dt), CONFIG_DEFAULT_DEADZONE, CONFIG_SLEW_RUNNING_MAX_RATE * dt, true, curves);
+        joy::processAxesBatch(raw[(i >> 8) & 1], filtered, out, tickParams);
+    }, iterations);
+    double fixedNs = timeNsPerOp([&](int i) {
+        joy::processAxesFixed(raw[(i >> 8) & 1], filtered, out, false);
+    }, iterations);
+
+    std::printf("processAxesScalar %8.2f ns/op (8 axes)\n", scalarNs);
+    std::printf("processAxesBatch  %8.2f ns/op (8 axes)\n", batchNs);
+    std::printf("cached + batch    %8.2f ns/op (8 axes, cached params, alpha/maxDelta per tick)\n", cachedBatchNs);
+    std::printf("params + batch    %8.2f ns/op (8 axes, makeAxisPipelineParams every tick)\n", paramsBatchNs);
+    std::printf("processAxesFixed  %8.2f ns/op (8 axes, CONFIG_* constants%s)\n", fixedNs,
+#ifdef CONFIG_USE_SLEW
+                ", slew"
+#else
+                ", no slew"
+#endif
+    );
+    std::printf("(checksum %g)\n", out[0] + filtered[0]);
+    return ok ? 0 : 1;
+}
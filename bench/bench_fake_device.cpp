@@ -0,0 +1,272 @@
+// 가짜 joydev 장치(FakeJoystick)로 실제 JoystickManager 루프를 돌리는 벤치마크 겸 경로 점검
+//
+// 게임패드 없이 Polling / EventDriven 두 루프 방식 각각에 대해:
+// 1) 경로 점검: 초기화 게이팅(START 전 입력 무시), Kill Switch, 뽑기 → 디스커넥트 → 다시 꽂기 → 재연결.
+//    가짜 장치는 mkdtemp 디렉터리의 노드 파일로 꽂히므로 재연결은 1초 간격 시도가 아니라 핫플러그
+//    알림으로 잡혀야 하고(< 50ms), 같은 디렉터리에 다른 노드가 생겨도 장치를 열어 보지 않아야 합니다.
+// 1-1) JoystickService: 1Hz 루프(주기 1초)에서도 stop()이 바로 돌아오는지, 같은 객체로 다시 start()되는지,
+//      stop() 뒤 출력이 0이고 입력이 꺼지는지, 다시 start()하면 START 전까지 축 입력을 무시하는지
+// 2) 이벤트 폭주: 1kHz로 8축을 모두 움직이고(ms당 8이벤트) 100ms마다 256이벤트 버스트를 섞어
+//    초당 처리 이벤트 수, 한 틱 최대 이벤트 수, 입력/읽기 지연(p50/p99/max)을 출력합니다.
+// 점검이 하나라도 실패하면 종료 코드 1로 끝납니다.
+//
+//   ./bench_fake_device [폭주 시간(초), 기본 2]
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "fake_joystick.h"
+#include "input_backend.h"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+bool g_ok = true;
+
+void check(const char *mode, const char *name, bool ok) {
+    std::printf("[%s] %-34s %s\n", mode, name, ok ? "OK" : "FAIL");
+    g_ok = g_ok && ok;
+}
+
+// cond가 참이 될 때까지 최대 timeoutMs 동안 기다림. 걸린 시간(ms)을 돌려주고, 시간 초과면 -1
+double waitFor(const std::function<bool()> &cond, int timeoutMs) {
+    auto start = Clock::now();
+    while (!cond()) {
+        double elapsed = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (elapsed > timeoutMs) {
+            return -1.0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void pressButton(joy::FakeJoystick &pad, int button) {
+    pad.button(button, true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pad.button(button, false);
+}
+
+void printLatency(const char *mode, const char *name, const joy::LatencySnapshot &s) {
+    std::printf("[%s] %-7s latency: n=%llu p50 %.1f us, p99 %.1f us, max %.1f us\n", mode, name,
+                static_cast<unsigned long long>(s.count), s.p50 / 1e3, s.p99 / 1e3, s.max / 1e3);
+}
+
+// 1kHz 8축 폭주 + 100ms마다 버스트. 쓴 이벤트 수를 돌려줌
+uint64_t writeStorm(joy::FakeJoystick &pad, double seconds) {
+    constexpr int BURST_EVENTS = 256;
+    uint64_t written = 0;
+    js_event tick[joy::MAX_AXES];
+    std::vector<js_event> burst(BURST_EVENTS);
+
+    auto start = Clock::now();
+    auto next = start;
+    for (long long ms = 0; std::chrono::duration<double>(Clock::now() - start).count() < seconds; ++ms) {
+        for (int a = 0; a < joy::MAX_AXES; ++a) {
+            int16_t value = static_cast<int16_t>(((ms + a * 125) * 2731) % 65535 - 32767);
+            tick[a] = joy::FakeJoystick::makeEvent(JS_EVENT_AXIS, static_cast<uint8_t>(a), value);
+        }
+        pad.write(tick, joy::MAX_AXES);
+        written += joy::MAX_AXES;
+
+        if (ms % 100 == 0) {
+            for (int i = 0; i < BURST_EVENTS; ++i) {
+                burst[i] = joy::FakeJoystick::makeEvent(JS_EVENT_AXIS, static_cast<uint8_t>(i % joy::MAX_AXES),
+                                                        static_cast<int16_t>(i * 255 - 32640));
+            }
+            pad.write(burst.data(), burst.size());
+            written += BURST_EVENTS;
+        }
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+    }
+    return written;
+}
+
+// dir에 빈 파일 name을 만들었다 지움 (핫플러그 감시에 다른 장치 노드처럼 보임)
+void touchNode(const std::string &dir, const char *name) {
+    std::string path = dir + "/" + name;
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    ::unlink(path.c_str());
+}
+
+void runMode(joy::LoopMode loopMode, const char *mode, const std::string &nodeDir, double stormSeconds) {
+    joy::setLoopMode(loopMode);
+
+    const std::string nodePath = nodeDir + "/js0";
+    joy::JoystickConfig config = joy::defaultJoystickConfig(nodePath.c_str());
+    config.initDelaySec = 0.0f;
+    config.loopHz = 1000;
+
+    joy::FakeJoystick pad(nodePath);
+    joy::JoystickManager manager;
+    joy::JoystickDevice &device = manager.addDevice(config);
+    std::atomic<int> opens{0};   // 장치가 백엔드를 열어 본 횟수 (꽂혀 있지 않아도 셈)
+    joy::InputBackendFactory padFactory = pad.factory();
+    device.setBackendFactory([&](const joy::JoystickConfig &c) {
+        opens.fetch_add(1);
+        return padFactory(c);
+    });
+    pad.plug();
+
+    joy::JoystickService service(manager);
+    check(mode, "connect", service.start() && waitFor([&] { return device.isConnected(); }, 1000) >= 0);
+
+    // 초기화 게이팅: START 전의 스틱 입력은 반영되지 않아야 함
+    pad.axis(1, 32767);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    check(mode, "gating (axis ignored before START)",
+          !device.isInputEnabled() && device.getState().axes[1] == 0.0f);
+
+    pressButton(pad, config.buttonStart);
+    check(mode, "START enables input", waitFor([&] { return device.isInputEnabled(); }, 500) >= 0);
+    check(mode, "axis reaches output", waitFor([&] { return device.getState().axes[1] > 0.0f; }, 500) >= 0);
+
+    // 이벤트 폭주: 소비자 하나가 waitForUpdate로 모든 발행을 따라감
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));   // START 뗌 이벤트까지 반영
+    device.resetLatency();
+    joy::JoystickStats before = device.getStats();
+    std::atomic<bool> consuming{true};
+    std::atomic<uint64_t> updates{0};
+    std::thread consumer([&] {
+        joy::JoystickState state = {};
+        while (consuming.load(std::memory_order_relaxed)) {
+            if (device.waitForUpdate(state.sequence, state, 100)) {
+                updates.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    auto t0 = Clock::now();
+    uint64_t written = writeStorm(pad, stormSeconds);
+    waitFor([&] { return device.getStats().totalEvents - before.totalEvents >= written; }, 500);
+    double wallS = std::chrono::duration<double>(Clock::now() - t0).count();
+    consuming.store(false);
+    consumer.join();
+
+    joy::JoystickStats after = device.getStats();
+    joy::JoystickLatency latency = device.getLatency();
+    uint64_t processed = after.totalEvents - before.totalEvents;
+    std::printf("[%s] storm: %llu events written, %llu processed in %.2f s = %.0f events/s, "
+                "max %u events/tick, %llu ticks, %llu missed, %llu updates read\n",
+                mode, static_cast<unsigned long long>(written), static_cast<unsigned long long>(processed),
+                wallS, processed / wallS, after.maxTickEvents,
+                static_cast<unsigned long long>(after.ticks - before.ticks),
+                static_cast<unsigned long long>(after.missedTicks - before.missedTicks),
+                static_cast<unsigned long long>(updates.load()));
+    printLatency(mode, "input", latency.input);
+    printLatency(mode, "process", latency.process);
+    printLatency(mode, "read", latency.read);
+    check(mode, "storm: no events lost", processed == written);
+
+    // Kill Switch: 입력 비활성화 + 출력 0
+    pressButton(pad, config.buttonKill);
+    check(mode, "kill switch disables input", waitFor([&] { return !device.isInputEnabled(); }, 500) >= 0);
+    pad.axis(1, 32767);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    check(mode, "outputs zero after kill", device.getState().axes[1] == 0.0f);
+
+    // 뽑기 → 디스커넥트, 다시 꽂기 → 핫플러그로 재연결 (1초 간격 시도를 기다리지 않음) 후 다시 START 필요
+    pressButton(pad, config.buttonStart);
+    waitFor([&] { return device.isInputEnabled(); }, 500);
+    pad.unplug();
+    check(mode, "unplug disconnects",
+          waitFor([&] { return !device.isConnected() && !device.isInputEnabled(); }, 500) >= 0);
+
+    // 같은 디렉터리에 다른 노드(마우스, 다른 패드)가 생겨도 재연결을 시도하지 않아야 함
+    int opensBefore = opens.load();
+    touchNode(nodeDir, "mouse0");
+    touchNode(nodeDir, "js1");
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    check(mode, "unrelated nodes ignored", opens.load() == opensBefore);
+
+    pad.plug();
+    double reconnectMs = waitFor([&] { return device.isConnected(); }, 2500);
+    std::printf("[%s] reconnect after %.1f ms\n", mode, reconnectMs);
+    check(mode, "replug reconnects (< 50 ms)", reconnectMs >= 0 && reconnectMs < 50.0);
+    check(mode, "gating again after reconnect", !device.isInputEnabled());
+
+    service.stop();
+}
+
+// 주기 1초 루프에서 stop()을 부른다. 루프 대기를 stop eventfd로 깨우지 못하면 최대 1초가 걸린다.
+// 틱이 1초에 한 번이므로 버튼은 짧게 누르지 않고 반영될 때까지 누르고 있는다.
+void runServiceStop(joy::LoopMode loopMode, const char *mode) {
+    joy::setLoopMode(loopMode);
+
+    joy::JoystickConfig config = joy::defaultJoystickConfig("fake");
+    config.loopHz = 1;
+    config.initDelaySec = 0.0f;
+
+    joy::FakeJoystick pad;
+    joy::JoystickManager manager;
+    joy::JoystickDevice &device = manager.addDevice(config);
+    device.setBackendFactory(pad.factory());
+
+    joy::JoystickService service(manager);
+    for (int round = 0; round < 2; ++round) {
+        pad.plug();   // stop()이 장치를 닫으므로 가짜 장치는 다시 꽂아야 다시 열린다
+        bool started = service.start();
+        check(mode, round == 0 ? "service start" : "service restart",
+              started && waitFor([&] { return device.isConnected(); }, 1000) >= 0);
+
+        if (round == 0) {
+            // START → 축을 밀어 출력이 살아 있는 상태에서 멈춘다
+            pad.button(config.buttonStart, true);
+            check(mode, "service enables after START", waitFor([&] { return device.isInputEnabled(); }, 2500) >= 0);
+            pad.button(config.buttonStart, false);
+            pad.axis(1, 16384);
+            check(mode, "axis live before stop", waitFor([&] { return device.getState().axes[1] != 0.0f; }, 2500) >= 0);
+        } else {
+            // 다시 시작한 뒤 START 없이 움직인 축은 무시되어야 한다
+            pad.axis(1, -16384);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1200));   // 틱 한 번 이상
+            check(mode, "restart gated until START",
+                  !device.isInputEnabled() && device.getState().axes[1] == 0.0f);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));   // 루프가 틱 대기에 들어가도록
+
+        auto t0 = Clock::now();
+        service.stop();
+        double stopMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        std::printf("[%s] service stop took %.2f ms (loop period 1000 ms)\n", mode, stopMs);
+        check(mode, "stop interrupts wait (< 50 ms)", stopMs < 50.0 && !service.isRunning());
+        check(mode, "stop disables input, zero outputs",
+              !device.isConnected() && !device.isInputEnabled() && device.getState().axes[1] == 0.0f);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    double stormSeconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+
+    // 가짜 장치 노드를 둘 디렉터리 (핫플러그 감시는 절대 경로의 상위 디렉터리만 본다)
+    char nodeDir[] = "/tmp/joy_fake_XXXXXX";
+    if (mkdtemp(nodeDir) == nullptr) {
+        std::perror("mkdtemp");
+        return 1;
+    }
+
+    runMode(joy::LoopMode::Polling, "polling", nodeDir, stormSeconds);
+    runMode(joy::LoopMode::EventDriven, "event", nodeDir, stormSeconds);
+    runServiceStop(joy::LoopMode::Polling, "polling");
+    runServiceStop(joy::LoopMode::EventDriven, "event");
+
+    ::rmdir(nodeDir);
+
+    std::printf("fake device checks: %s\n", g_ok ? "OK" : "FAIL");
+    return g_ok ? 0 : 1;
+}
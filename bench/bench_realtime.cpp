@@ -0,0 +1,115 @@
+// 작업 스레드 실시간 설정(JoystickService / RealtimeThread) 효과 측정
+//
+// CPU 개수의 두 배만큼 바쁜 루프 스레드로 CPU를 모두 채운 상태에서, 가짜 joydev 장치(FakeJoystick)를
+// 1kHz Polling 루프로 돌려 기대 틱 수 대비 실제 틱 수와 놓친 틱(missedTicks)을 비교합니다.
+//   normal   : 기본 스케줄링 (SCHED_OTHER)
+//   realtime : SCHED_FIFO 우선순위 + 메모리 잠금 + 스택 prefault
+// SCHED_FIFO 권한이 없으면 realtime도 SCHED_OTHER로 돌고, 보고 줄에 실패 이유가 나옵니다.
+// 작업 스레드를 만들지 못했거나 장치가 1초 안에 연결되지 않으면 종료 코드 1로 끝납니다.
+//
+//   ./bench_realtime [시간(초), 기본 2] [SCHED_FIFO 우선순위, 기본 80]
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fake_joystick.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// cond가 참이 될 때까지 최대 timeoutMs 동안 기다림. 시간 초과면 false
+bool waitFor(const std::function<bool()> &cond, int timeoutMs) {
+    auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (!cond()) {
+        if (Clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+bool runCase(const char *name, const joy::RealtimeOptions &options, double seconds) {
+    joy::setLoopMode(joy::LoopMode::Polling);
+    joy::JoystickConfig config = joy::defaultJoystickConfig("fake");
+    config.initDelaySec = 0.0f;
+    config.loopHz = 1000;
+
+    joy::FakeJoystick pad;
+    joy::JoystickManager manager;
+    joy::JoystickDevice &device = manager.addDevice(config);
+    device.setBackendFactory(pad.factory());
+    pad.plug();
+
+    joy::JoystickService service(manager);
+    std::string error;
+    if (!service.start(options, &error)) {
+        std::printf("[%s] service start failed: %s\n", name, error.c_str());
+        return false;
+    }
+    std::printf("[%s] worker: %s\n", name, joy::formatRealtimeReport(service.threadReport()).c_str());
+    if (!waitFor([&] { return device.isConnected(); }, 1000)) {
+        std::printf("[%s] fake device did not connect within 1 s\n", name);
+        service.stop();
+        return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // CPU 부하: 하드웨어 스레드 수의 두 배만큼 바쁜 루프
+    std::atomic<bool> loading{true};
+    std::vector<std::thread> hogs;
+    unsigned cpus = std::thread::hardware_concurrency();
+    for (unsigned i = 0; i < 2 * (cpus ? cpus : 1); ++i) {
+        hogs.emplace_back([&loading] {
+            volatile uint64_t spin = 0;
+            while (loading.load(std::memory_order_relaxed)) {
+                ++spin;
+            }
+        });
+    }
+
+    joy::JoystickStats before = device.getStats();
+    auto t0 = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    joy::JoystickStats after = device.getStats();
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    loading.store(false);
+    for (std::thread &hog : hogs) {
+        hog.join();
+    }
+    service.stop();
+
+    uint64_t ticks = after.ticks - before.ticks;
+    uint64_t missed = after.missedTicks - before.missedTicks;
+    double expected = wallS * config.loopHz;
+    std::printf("[%s] under load (%zu busy threads): %llu ticks of %.0f expected (%.1f%%), %llu missed\n", name,
+                hogs.size(), static_cast<unsigned long long>(ticks), expected, 100.0 * ticks / expected,
+                static_cast<unsigned long long>(missed));
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    double seconds = argc > 1 ? std::atof(argv[1]) : 2.0;
+    int priority = argc > 2 ? std::atoi(argv[2]) : 80;
+
+    joy::RealtimeOptions normal = joy::defaultRealtimeOptions();
+    normal.priority = 0;
+    normal.lockMemory = false;
+    bool ok = runCase("normal", normal, seconds);
+
+    joy::RealtimeOptions realtime = joy::defaultRealtimeOptions();
+    realtime.priority = priority;
+    realtime.lockMemory = true;
+    ok = runCase("realtime", realtime, seconds) && ok;
+    return ok ? 0 : 1;
+}
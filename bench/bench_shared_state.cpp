@@ -0,0 +1,154 @@
+// 공유 메모리 발행(SharedStatePublisher / SharedStateReader) 프로세스 간 벤치마크
+//
+// 1) load: 다른 프로세스가 발행하지 않는 동안 SharedStateReader::load()의 ns/op
+// 2) 프로세스 간 전달: 부모가 1kHz로 JoystickState를 발행하고, fork한 reader 프로세스 N개가
+//    waitForUpdate(futex)로 받아 발행 → 수신 지연(p50/p99/max)과 놓친 발행 수를 보고합니다.
+//    reader는 최신 상태만 보므로 지연이 한 주기를 넘으면 중간 상태를 건너뛸 수 있습니다(missed).
+// reader 하나라도 마지막 상태를 받지 못하면 종료 코드 1로 끝납니다.
+//
+//   ./bench_shared_state [reader 수, 기본 3] [시간(초), 기본 2]
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "shared_state.h"
+
+namespace {
+
+int64_t monotonicNowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+
+// reader 프로세스가 파이프로 돌려주는 결과
+struct ReaderResult {
+    uint64_t received;
+    uint64_t missed;
+    int64_t  p50;
+    int64_t  p99;
+    int64_t  max;
+    bool     sawLast;
+};
+
+// 마지막 발행은 buttons[0] = 1로 표시
+ReaderResult runReader(const char *name) {
+    ReaderResult result = {};
+    joy::SharedStateReader reader;
+    if (!reader.open(name)) {
+        return result;
+    }
+    joy::LatencyHistogram latency;
+    joy::JoystickState state = reader.load();
+    uint64_t previous = state.sequence;
+    while (reader.waitForUpdate(state.sequence, state, 1000)) {
+        latency.record(monotonicNowNs() - state.publishTimeNs);
+        ++result.received;
+        if (previous != 0 && state.sequence > previous + 1) {
+            result.missed += state.sequence - previous - 1;
+        }
+        previous = state.sequence;
+        if (state.buttons[0] == 1) {
+            result.sawLast = true;
+            break;
+        }
+    }
+    joy::LatencySnapshot snap = latency.snapshot();
+    result.p50 = snap.p50;
+    result.p99 = snap.p99;
+    result.max = snap.max;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int readers = argc > 1 ? std::atoi(argv[1]) : 3;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2.0;
+    std::string name = "/joystick_bench_" + std::to_string(getpid());
+
+    joy::SharedStatePublisher publisher;
+    std::string error;
+    if (!publisher.open(name.c_str(), &error)) {
+        std::printf("%s\n", error.c_str());
+        return 1;
+    }
+    joy::JoystickState state = {};
+    state.sequence = 1;
+    state.publishTimeNs = monotonicNowNs();
+    publisher.publish(state);
+
+    // 1) load ns/op (발행 없음)
+    {
+        joy::SharedStateReader reader;
+        reader.open(name.c_str());
+        const long long iterations = 10000000;
+        float sink = 0.0f;
+        auto t0 = std::chrono::steady_clock::now();
+        for (long long i = 0; i < iterations; ++i) {
+            sink += reader.load().axes[0];
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / iterations;
+        std::printf("SharedStateReader::load  %8.2f ns/op (checksum %g)\n", ns, sink);
+    }
+
+    // 2) 1kHz 발행 → reader 프로세스 N개
+    int pipes[2];
+    if (pipe(pipes) != 0) {
+        return 1;
+    }
+    for (int r = 0; r < readers; ++r) {
+        if (fork() == 0) {
+            ::close(pipes[0]);
+            ReaderResult result = runReader(name.c_str());
+            ssize_t written = write(pipes[1], &result, sizeof(result));
+            _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+        }
+    }
+    ::close(pipes[1]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));  // reader가 붙을 시간
+
+    auto start = std::chrono::steady_clock::now();
+    auto next = start;
+    uint64_t published = 0;
+    while (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() < seconds) {
+        ++state.sequence;
+        state.axes[0] = static_cast<float>(state.sequence % 1000) / 1000.0f;
+        state.publishTimeNs = monotonicNowNs();
+        publisher.publish(state);
+        ++published;
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+    }
+    ++state.sequence;
+    state.buttons[0] = 1;
+    state.publishTimeNs = monotonicNowNs();
+    publisher.publish(state);
+    ++published;
+
+    bool ok = true;
+    for (int r = 0; r < readers; ++r) {
+        ReaderResult result = {};
+        if (read(pipes[0], &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result))) {
+            result = {};
+        }
+        std::printf("reader %d: %llu/%llu received, %llu missed, latency p50 %.1f us, p99 %.1f us, max %.1f us%s\n", r,
+                    static_cast<unsigned long long>(result.received), static_cast<unsigned long long>(published),
+                    static_cast<unsigned long long>(result.missed), result.p50 / 1e3, result.p99 / 1e3,
+                    result.max / 1e3, result.sawLast ? "" : "  FAIL");
+        ok = ok && result.sawLast;
+    }
+    while (wait(nullptr) > 0) {
+    }
+    publisher.close();
+    joy::SharedStatePublisher::unlink(name.c_str());
+
+    std::printf("shared state readers: %s\n", ok ? "OK" : "FAIL");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+// 헤드리스 시뮬레이터 벤치마크 및 튜닝 스윕 예제
+//
+// 1) 벤치마크: 1kHz로 1시간 분량(360만 틱)의 스크립트 입력(START, 스틱 스텝, 누적 버튼, Kill Switch)을
+//    JoystickSimulator로 돌려 초당 틱 수를 잽니다. 같은 스크립트를 두 번 돌려 결과가
+//    비트 단위로 같은지도 확인하며, 다르면 종료 코드 1로 끝납니다.
+// 2) 스윕: filter_tau 값마다 스틱 스텝 입력의 90% 도달 시간을 출력합니다.
+// 3) 필터 비교: EMA / Butterworth / 임계 감쇠 / One-Euro 필터마다, 스틱을 절반에 두고 raw 잡음(σ = 2000)을
+//    섞었을 때의 출력 잡음(표준편차)과 스텝 입력의 90% 도달 시간을 출력합니다 (선형 곡선, 데드존 0).
+//    같은 잡음 수준에서 도달 시간이 짧을수록 위상 지연이 작은 필터입니다.
+//    One-Euro는 최소 차단 주파수를 EMA 0.66초와 같은 0.24Hz로 두고 beta만 바꿉니다.
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "simulator.h"
+
+namespace {
+
+constexpr int64_t MS = 1000000LL;
+constexpr int64_t SEC = 1000 * MS;
+
+// 10분마다 START를 누른 뒤 0.5초마다 스틱 방향을 바꾸고, 가끔 누적 버튼과 Kill Switch를 누르는 스크립트
+void scriptSession(joy::JoystickSimulator &sim, const joy::JoystickConfig &config, int64_t durationNs) {
+    for (int64_t t = 0; t < durationNs; t += 600 * SEC) {
+        int64_t start = t + static_cast<int64_t>(config.initDelaySec * SEC) + 100 * MS;
+        sim.button(start, config.buttonStart, true);
+        sim.button(start + 50 * MS, config.buttonStart, false);
+        for (int64_t s = start + 500 * MS, k = 0; s < t + 599 * SEC; s += 500 * MS, ++k) {
+            sim.axis(s, 1, (k % 2 ? -1.0f : 1.0f) * 32767.0f);
+            sim.axis(s, 3, static_cast<float>((k * 7919) % 65535 - 32767));
+            if (k % 5 == 0) {
+                sim.button(s, config.buttonR1, true);
+                sim.button(s + 200 * MS, config.buttonR1, false);
+            }
+        }
+        sim.button(t + 599 * SEC, config.buttonKill, true);
+        sim.button(t + 599 * SEC + 50 * MS, config.buttonKill, false);
+    }
+}
+
+// 0 → 최대 스텝의 90% 도달 시간 (ns, 도달하지 못하면 -1)
+int64_t stepRiseNs(const joy::JoystickConfig &config) {
+    joy::JoystickSimulator sim(config);
+    sim.button(0, config.buttonStart, true);
+    sim.axis(100 * MS, 1, 32767.0f);
+    sim.run(100 * MS);
+    int64_t reachedNs = -1;
+    sim.run(10 * SEC, [&](const joy::JoystickState &state) {
+        if (reachedNs < 0 && state.axes[1] >= 0.9f) {
+            reachedNs = sim.nowNs() - 100 * MS;
+        }
+    });
+    return reachedNs;
+}
+
+// 스틱을 절반에 두고 매 ms raw 잡음을 섞었을 때 출력의 표준편차 (수렴 뒤 4초)
+double outputNoise(const joy::JoystickConfig &config) {
+    std::mt19937 rng(7);
+    std::normal_distribution<float> noise(0.0f, 2000.0f);
+    joy::JoystickSimulator sim(config);
+    sim.button(0, config.buttonStart, true);
+    for (int64_t t = 1 * MS; t < 8 * SEC; t += MS) {
+        sim.axis(t, 1, 16384.0f + noise(rng));
+    }
+    sim.run(4 * SEC);
+    double sum = 0.0, sumSq = 0.0;
+    long long n = 0;
+    sim.run(4 * SEC, [&](const joy::JoystickState &state) {
+        sum += state.axes[1];
+        sumSq += static_cast<double>(state.axes[1]) * state.axes[1];
+        ++n;
+    });
+    double mean = sum / n;
+    return std::sqrt(std::max(0.0, sumSq / n - mean * mean));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int64_t durationNs = (argc > 1 ? std::atoll(argv[1]) : 3600) * SEC;
+
+    joy::JoystickConfig config = joy::defaultJoystickConfig("sim");
+    config.loopHz = 1000;
+
+    joy::JoystickState final[2];
+    for (int run = 0; run < 2; ++run) {
+        joy::JoystickSimulator sim(config);
+        scriptSession(sim, config, durationNs);
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t ticks = sim.run(durationNs);
+        double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        final[run] = sim.state();
+        std::printf("run %d: %llu ticks (%.0f s simulated) in %.3f s wall = %.2f M ticks/s\n", run,
+                    static_cast<unsigned long long>(ticks), durationNs / 1e9, wallS, ticks / wallS / 1e6);
+    }
+    bool same = std::memcmp(&final[0], &final[1], sizeof(joy::JoystickState)) == 0;
+    std::printf("deterministic: %s\n", same ? "OK" : "FAIL");
+
+    // filter_tau 스윕: 0 → 최대 스텝의 90% 도달 시간
+    config.initDelaySec = 0.0f;
+    for (float tau : {0.1f, 0.33f, 0.66f, 1.0f}) {
+        config.filterTau = tau;
+        joy::JoystickSimulator sim(config);
+        sim.button(0, config.buttonStart, true);
+        sim.axis(100 * MS, 1, 32767.0f);
+        sim.run(100 * MS);
+        int64_t reachedNs = -1;
+        sim.run(10 * SEC, [&](const joy::JoystickState &state) {
+            if (reachedNs < 0 && state.axes[1] >= 0.9f) {
+                reachedNs = sim.nowNs() - 100 * MS;
+            }
+        });
+        std::printf("filter_tau %.2f: 90%% after %.0f ms\n", tau, reachedNs / 1e6);
+    }
+
+    // 필터 비교 (선형 곡선, 데드존 0, 슬루 끔)
+    joy::JoystickConfig compare = config;
+    compare.deadZone = 0.0f;
+    compare.useSlew = false;
+    for (int i = 0; i < joy::MAX_AXES; ++i) {
+        compare.curves.axes[i] = joy::makeResponseCurve(joy::CurveType::Linear, 0.0f);
+    }
+    struct Case { const char *name; joy::FilterType type; float value; float beta; };
+    const Case cases[] = {
+        {"ema tau", joy::FilterType::Ema, 0.66f, 0.0f},
+        {"ema tau", joy::FilterType::Ema, 0.33f, 0.0f},
+        {"butterworth fc", joy::FilterType::Butterworth, 0.5f, 0.0f},
+        {"butterworth fc", joy::FilterType::Butterworth, 1.0f, 0.0f},
+        {"butterworth fc", joy::FilterType::Butterworth, 2.0f, 0.0f},
+        {"critically_damped fc", joy::FilterType::CriticallyDamped, 1.0f, 0.0f},
+        {"critically_damped fc", joy::FilterType::CriticallyDamped, 2.0f, 0.0f},
+        {"one_euro fc", joy::FilterType::OneEuro, 0.24f, 0.1f},
+        {"one_euro fc", joy::FilterType::OneEuro, 0.24f, 0.3f},
+        {"one_euro fc", joy::FilterType::OneEuro, 0.24f, 1.0f},
+    };
+    for (const Case &c : cases) {
+        compare.filterType = c.type;
+        if (c.type == joy::FilterType::Ema) {
+            compare.filterTau = c.value;
+        } else {
+            compare.filterCutoffHz = c.value;
+        }
+        compare.oneEuroBeta = c.beta;
+        double noiseStd = outputNoise(compare);
+        int64_t riseNs = stepRiseNs(compare);
+        if (c.type == joy::FilterType::OneEuro) {
+            std::printf("%-20s %5.2f beta %4.2f: output noise %.4f, 90%% after %4.0f ms\n", c.name, c.value, c.beta,
+                        noiseStd, riseNs / 1e6);
+        } else {
+            std::printf("%-20s %5.2f:           output noise %.4f, 90%% after %4.0f ms\n", c.name, c.value, noiseStd,
+                        riseNs / 1e6);
+        }
+    }
+    return same ? 0 : 1;
+}
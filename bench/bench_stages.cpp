@@ -0,0 +1,248 @@
+// 파이프라인 단계별 마이크로벤치마크
+//
+// 1) 단계 함수: lowpassFilter_Joy, normalizeAxisValue, scaleJoystickOutput, applySlewRate,
+//    processAxesBatch, updateAccumulators, updateSharedState의 호출당 시간(ns/op)과 처리량
+// 2) 전체 틱: JoystickSimulator로 readPendingEvents + tick(게이팅, 필터, 누적기, 발행) 한 번
+// 3) getState: 작업 스레드가 1kHz로 발행하는 동안 reader 1..N개가 동시에 읽을 때의 ns/op
+//
+// 회귀 감시:
+//   ./bench_stages --save stages_baseline.txt     현재 결과를 기준값으로 저장
+//   ./bench_stages --check stages_baseline.txt    기준값보다 TOLERANCE배 넘게 느린 항목이 있으면 종료 코드 1
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simulator.h"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// 기준값 대비 허용 배수 (측정 잡음을 고려)
+constexpr double TOLERANCE = 1.5;
+
+struct Result {
+    std::string name;
+    double nsPerOp;
+};
+
+// 결과를 컴파일러가 버리지 못하게 함
+float g_sink = 0.0f;
+
+template <typename Fn>
+double timeNsPerOp(Fn fn, long long iterations) {
+    auto t0 = Clock::now();
+    for (long long i = 0; i < iterations; ++i) {
+        fn(i);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / iterations;
+}
+
+void report(std::vector<Result> &results, const std::string &name, double nsPerOp) {
+    std::printf("%-28s %9.2f ns/op %10.2f M ops/s\n", name.c_str(), nsPerOp, 1e3 / nsPerOp);
+    results.push_back(Result{name, nsPerOp});
+}
+
+void benchStages(std::vector<Result> &results, long long iterations) {
+    const joy::JoystickConfig config = joy::defaultJoystickConfig("sim");
+    const float dt = 1.0f / CONFIG_JOYSTICK_HZ;
+    const float alpha = dt / (config.filterTau + dt);
+    const float maxDelta = config.slewRunningMaxRate * dt;
+    const joy::ResponseCurve curve = config.curves.axes[0];
+
+    // 입력이 매번 달라지도록 i로 값을 바꾼다
+    float raw[256];
+    for (int i = 0; i < 256; ++i) {
+        raw[i] = static_cast<float>((i * 2731) % 65535 - 32767);
+    }
+
+    float acc = 0.0f;
+    report(results, "lowpassFilter_Joy", timeNsPerOp([&](long long i) {
+        acc = joy::lowpassFilter_Joy(acc, raw[i & 255], alpha);
+    }, iterations));
+    report(results, "normalizeAxisValue", timeNsPerOp([&](long long i) {
+        acc += joy::normalizeAxisValue(raw[i & 255]);
+    }, iterations));
+    report(results, "scaleJoystickOutput", timeNsPerOp([&](long long i) {
+        acc += joy::scaleJoystickOutput(raw[i & 255] / 32767.0f, config.deadZone, curve);
+    }, iterations));
+    report(results, "applySlewRate", timeNsPerOp([&](long long i) {
+        acc = joy::applySlewRate(acc, raw[i & 255] / 32767.0f, maxDelta);
+    }, iterations));
+    g_sink += acc;
+
+    joy::AxisPipelineParams params =
+        joy::makeAxisPipelineParams(alpha, config.deadZone, maxDelta, config.useSlew, config.curves);
+    float filtered[joy::MAX_AXES] = {}, out[joy::MAX_AXES] = {};
+    report(results, "processAxesBatch (8 axes)", timeNsPerOp([&](long long i) {
+        joy::processAxesBatch(raw + (i & 127), filtered, out, params);
+    }, iterations));
+    g_sink += out[0];
+
+    joy::JoystickState local[2] = {};
+    local[1].buttons[config.buttonL1] = 1;
+    local[1].buttons[config.buttonR2] = 1;
+    joy::JoystickState head = {};
+    report(results, "updateAccumulators", timeNsPerOp([&](long long i) {
+        joy::updateAccumulators(head, local[(i >> 4) & 1], dt, config);
+    }, iterations));
+
+    joy::AxisFilterState filter = {};
+    joy::resetFilterState(filter);
+    for (int i = 0; i < joy::MAX_AXES; ++i) {
+        local[0].axes[i] = raw[i * 3];
+        local[1].axes[i] = raw[i * 5 + 1];
+    }
+    report(results, "updateSharedState", timeNsPerOp([&](long long i) {
+        joy::updateSharedState(head, filter, local[(i >> 8) & 1], dt, config);
+    }, iterations));
+    g_sink += head.axes[0] + head.lr1_accumulated;
+}
+
+// 게이팅을 통과한 장치에서 스틱을 계속 움직이며 틱 한 번(이벤트 반영 + 틱 + 발행)의 비용
+void benchFullTick(std::vector<Result> &results, long long iterations) {
+    joy::JoystickConfig config = joy::defaultJoystickConfig("sim");
+    config.initDelaySec = 0.0f;
+    config.loopHz = 1000;
+    joy::JoystickSimulator sim(config);
+    sim.button(0, config.buttonStart, true);
+    for (long long i = 0; i < iterations; i += 4) {
+        sim.axis(i * 1000000LL, static_cast<int>(i & 7), static_cast<float>((i * 2731) % 65535 - 32767));
+    }
+    sim.run(10000000LL);  // 게이팅 통과
+
+    auto t0 = Clock::now();
+    uint64_t ticks = sim.run(iterations * 1000000LL);
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count() / ticks;
+    report(results, "full tick (device)", ns);
+}
+
+// 작업 스레드가 1kHz로 발행하는 동안 reader 스레드들이 getState()를 쉬지 않고 호출
+double benchGetState(int readers, double seconds) {
+    joy::JoystickConfig config = joy::defaultJoystickConfig("sim");
+    config.initDelaySec = 0.0f;
+    config.loopHz = 1000;
+    joy::JoystickSimulator sim(config);
+    sim.button(0, config.buttonStart, true);
+    for (int i = 0; i < 100000; ++i) {
+        sim.axis(i * 1000000LL, i & 7, static_cast<float>((i * 2731) % 65535 - 32767));
+    }
+    joy::JoystickDevice &device = sim.device();
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> totalReads{0};
+    std::atomic<float> sink{0.0f};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            uint64_t reads = 0;
+            float acc = 0.0f;
+            while (running.load(std::memory_order_relaxed)) {
+                acc += device.getState().axes[0];
+                ++reads;
+            }
+            totalReads.fetch_add(reads);
+            sink.store(acc);
+        });
+    }
+
+    auto start = Clock::now();
+    auto next = start;
+    while (std::chrono::duration<double>(Clock::now() - start).count() < seconds) {
+        sim.run(1000000LL);  // 한 틱
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    running.store(false);
+    for (auto &t : threads) {
+        t.join();
+    }
+    g_sink += sink.load() * 0.0f;
+    return (elapsed * readers * 1e9) / static_cast<double>(totalReads.load());
+}
+
+bool saveBaseline(const char *path, const std::vector<Result> &results) {
+    std::ofstream file(path);
+    for (const Result &r : results) {
+        file << r.nsPerOp << ' ' << r.name << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+// 기준값과 비교. 느려진 항목이 있으면 false
+bool checkBaseline(const char *path, const std::vector<Result> &results) {
+    std::ifstream file(path);
+    if (!file) {
+        std::printf("cannot read baseline %s\n", path);
+        return false;
+    }
+    std::map<std::string, double> baseline;
+    double ns;
+    std::string name;
+    while (file >> ns && std::getline(file >> std::ws, name)) {
+        baseline[name] = ns;
+    }
+
+    bool ok = true;
+    for (const Result &r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end()) {
+            continue;
+        }
+        double ratio = r.nsPerOp / it->second;
+        if (ratio > TOLERANCE) {
+            std::printf("REGRESSION %-28s %9.2f ns/op (baseline %.2f, x%.2f)\n",
+                        r.name.c_str(), r.nsPerOp, it->second, ratio);
+            ok = false;
+        }
+    }
+    std::printf("baseline check: %s\n", ok ? "OK" : "FAIL");
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    const char *savePath = nullptr;
+    const char *checkPath = nullptr;
+    long long iterations = 10000000;
+    int maxReaders = 4;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            checkPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--readers") == 0 && i + 1 < argc) {
+            maxReaders = std::atoi(argv[++i]);
+        } else {
+            iterations = std::atoll(argv[i]);
+        }
+    }
+
+    std::vector<Result> results;
+    benchStages(results, iterations);
+    benchFullTick(results, std::max(1LL, iterations / 10));
+    for (int readers = 1; readers <= maxReaders; ++readers) {
+        report(results, "getState readers=" + std::to_string(readers), benchGetState(readers, 0.5));
+    }
+    std::printf("(checksum %g)\n", g_sink);
+
+    bool ok = true;
+    if (savePath) {
+        ok = saveBaseline(savePath, results);
+    }
+    if (checkPath) {
+        ok = checkBaseline(checkPath, results) && ok;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// getJoystickState() 발행 방식 비교 벤치마크: std::mutex vs SeqLock
+//
+// writer 스레드가 1kHz로 JoystickState를 발행하는 동안
+// reader 스레드 N개가 쉬지 않고 상태를 복사합니다.
+//  - reader: 호출당 평균 시간(ns/op)과 초당 처리량
+//  - writer: 발행 1회에 걸린 시간의 평균/최대 (reader 때문에 writer가 막히는 정도)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "joystick.h"
+#include "seqlock.h"
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// 기존 구현과 같은 방식: 뮤텍스로 보호되는 상태
+class MutexState {
+public:
+    void store(const joy::JoystickState &value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        state_ = value;
+    }
+    joy::JoystickState load() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return state_;
+    }
+private:
+    std::mutex mutex_;
+    joy::JoystickState state_ = {};
+};
+
+struct Result {
+    double readerNsPerOp;
+    double readerOpsPerSec;
+    double writerMeanNs;
+    double writerMaxNs;
+};
+
+template <typename Box>
+Result run(Box &box, int readers, double seconds) {
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> totalReads{0};
+    std::atomic<float> sink{0.0f};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            uint64_t reads = 0;
+            float acc = 0.0f;
+            while (running.load(std::memory_order_relaxed)) {
+                joy::JoystickState s = box.load();
+                acc += s.axes[0];
+                ++reads;
+            }
+            totalReads.fetch_add(reads);
+            sink.store(acc);
+        });
+    }
+
+    joy::JoystickState state = {};
+    double writerTotalNs = 0.0;
+    double writerMaxNs = 0.0;
+    uint64_t writes = 0;
+    auto start = Clock::now();
+    auto next = start;
+    while (std::chrono::duration<double>(Clock::now() - start).count() < seconds) {
+        for (int i = 0; i < joy::MAX_AXES; ++i) {
+            state.axes[i] = static_cast<float>(writes % 100) * 0.01f;
+        }
+        auto t0 = Clock::now();
+        box.store(state);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        writerTotalNs += ns;
+        writerMaxNs = std::max(writerMaxNs, ns);
+        ++writes;
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    running.store(false);
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    Result result;
+    double reads = static_cast<double>(totalReads.load());
+    result.readerOpsPerSec = reads / elapsed;
+    result.readerNsPerOp = readers > 0 ? (elapsed * readers * 1e9) / reads : 0.0;
+    result.writerMeanNs = writerTotalNs / writes;
+    result.writerMaxNs = writerMaxNs;
+    return result;
+}
+
+void print(const char *name, int readers, const Result &r) {
+    std::printf("%-8s readers=%d  read %8.1f ns/op %12.0f ops/s   write mean %8.1f ns  max %10.1f ns\n",
+                name, readers, r.readerNsPerOp, r.readerOpsPerSec, r.writerMeanNs, r.writerMaxNs);
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    int maxReaders = argc > 1 ? std::atoi(argv[1]) : 4;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 1.0;
+
+    for (int readers = 1; readers <= maxReaders; ++readers) {
+        MutexState mutexBox;
+        print("mutex", readers, run(mutexBox, readers, seconds));
+        joy::SeqLock<joy::JoystickState> seqBox;
+        print("seqlock", readers, run(seqBox, readers, seconds));
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+#ifndef JOYSTICK_BUTTON_EDGES_H
+#define JOYSTICK_BUTTON_EDGES_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace joy {
+
+// 버튼 하나의 눌림/뗌 변화
+struct ButtonEdge {
+    int64_t  timeNs;    // 이벤트 시각 (CLOCK_MONOTONIC ns. evdev: 커널 타임스탬프, joydev: 읽은 시각)
+    uint32_t button;    // 버튼 인덱스
+    uint32_t pressed;   // 1: 눌림, 0: 뗌
+};
+
+// 소비자마다 하나씩 가지는 읽기 위치. 생산자와 공유하지 않으므로 등록/해제가 필요 없습니다.
+struct ButtonEdgeCursor {
+    uint64_t next;      // 다음에 읽을 edge 번호
+    uint64_t dropped;   // 너무 늦게 읽어 덮어써진(놓친) edge 누적 수
+};
+
+/**
+ * @brief ButtonEdgeRing
+ *
+ * 단일 producer / 다중 consumer 브로드캐스트 링 버퍼.
+ *
+ *  - producer(push)는 절대 블록되지 않습니다. 가장 오래된 슬롯을 그냥 덮어씁니다.
+ *  - consumer(read)는 각자 ButtonEdgeCursor로 자기 속도대로 읽으며, 모든 consumer가
+ *    모든 edge를 받습니다. 뒤처져 덮어써진 만큼은 cursor.dropped에 더해집니다.
+ *  - 슬롯마다 SeqLock과 같은 방식의 버전을 두어, 읽는 도중 덮어써진 슬롯은 버립니다.
+ *
+ * @tparam CAPACITY  슬롯 수 (2의 거듭제곱)
+ */
+template <size_t CAPACITY>
+class ButtonEdgeRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+    static_assert(sizeof(ButtonEdge) % sizeof(uint32_t) == 0, "ButtonEdge must be a multiple of 4 bytes");
+
+public:
+    static constexpr size_t WORDS = sizeof(ButtonEdge) / sizeof(uint32_t);
+
+    ButtonEdgeRing() : head_(0) {
+        for (size_t i = 0; i < CAPACITY; ++i) {
+            slots_[i].version.store(0, std::memory_order_relaxed);
+            for (size_t w = 0; w < WORDS; ++w) {
+                slots_[i].data[w].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ButtonEdgeRing(const ButtonEdgeRing &) = delete;
+    ButtonEdgeRing &operator=(const ButtonEdgeRing &) = delete;
+
+    // edge 하나를 추가합니다. producer는 하나만 있어야 합니다.
+    void push(const ButtonEdge &edge) {
+        uint32_t words[WORDS];
+        std::memcpy(words, &edge, sizeof(edge));
+
+        uint64_t index = head_.load(std::memory_order_relaxed);
+        Slot &slot = slots_[index & (CAPACITY - 1)];
+        slot.version.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t w = 0; w < WORDS; ++w) {
+            slot.data[w].store(words[w], std::memory_order_relaxed);
+        }
+        slot.version.store(2 * index + 2, std::memory_order_release);
+        head_.store(index + 1, std::memory_order_release);
+    }
+
+    // 지금 이후에 추가되는 edge부터 읽는 cursor
+    ButtonEdgeCursor cursor() const {
+        return ButtonEdgeCursor{head_.load(std::memory_order_acquire), 0};
+    }
+
+    /**
+     * @brief cursor 위치부터 최대 maxEdges개를 out에 복사하고 cursor를 전진시킵니다
+     * @return 복사한 edge 수 (새 edge가 없으면 0)
+     */
+    size_t read(ButtonEdgeCursor &cursor, ButtonEdge *out, size_t maxEdges) const {
+        size_t count = 0;
+        while (count < maxEdges) {
+            uint64_t head = head_.load(std::memory_order_acquire);
+            if (cursor.next >= head) {
+                break;
+            }
+            if (head - cursor.next > CAPACITY) {
+                cursor.dropped += head - CAPACITY - cursor.next;
+                cursor.next = head - CAPACITY;
+            }
+
+            const Slot &slot = slots_[cursor.next & (CAPACITY - 1)];
+            uint32_t words[WORDS];
+            uint64_t before = slot.version.load(std::memory_order_acquire);
+            for (size_t w = 0; w < WORDS; ++w) {
+                words[w] = slot.data[w].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t after = slot.version.load(std::memory_order_relaxed);
+            if (before != 2 * cursor.next + 2 || after != before) {
+                continue;  // 읽는 사이에 producer가 한 바퀴 돌아 덮어씀: head를 다시 보고 건너뜀
+            }
+            std::memcpy(&out[count++], words, sizeof(ButtonEdge));
+            ++cursor.next;
+        }
+        return count;
+    }
+
+    // 지금까지 추가된 edge 수
+    uint64_t total() const {
+        return head_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> version;   // 2 * index + 2: 기록 완료, 홀수: 기록 중
+        std::atomic<uint32_t> data[WORDS];
+    };
+
+    alignas(64) std::atomic<uint64_t> head_;
+    Slot slots_[CAPACITY];
+};
+
+}  // namespace joy
+#endif // JOYSTICK_BUTTON_EDGES_H
@@ -0,0 +1,52 @@
+#ifndef JOYSTICK_CLOCK_H
+#define JOYSTICK_CLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <time.h>
+
+namespace joy {
+
+/**
+ * @brief Clock
+ *
+ * JoystickDevice가 초기화 대기, 재연결 간격, 발행 시각에 쓰는 시간원.
+ * 기본값은 실제 CLOCK_MONOTONIC(SystemClock)이고, 시뮬레이션에서는 ManualClock을 넣어
+ * 틱마다 시간을 직접 전진시키므로 벽시계 시간을 기다리지 않고 파이프라인을 돌릴 수 있습니다.
+ */
+class Clock {
+public:
+    virtual ~Clock() = default;
+    virtual int64_t nowNs() const = 0;   // CLOCK_MONOTONIC과 같은 기준의 ns
+};
+
+class SystemClock : public Clock {
+public:
+    int64_t nowNs() const override {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+    }
+};
+
+// set/advance로만 움직이는 시계 (다른 스레드에서 읽어도 안전)
+class ManualClock : public Clock {
+public:
+    explicit ManualClock(int64_t startNs = 0) : now_(startNs) {}
+
+    int64_t nowNs() const override { return now_.load(std::memory_order_relaxed); }
+    void set(int64_t ns) { now_.store(ns, std::memory_order_relaxed); }
+    void advance(int64_t ns) { now_.fetch_add(ns, std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> now_;
+};
+
+// 프로세스 전체가 공유하는 SystemClock
+inline const Clock &systemClock() {
+    static const SystemClock clock;
+    return clock;
+}
+
+}  // namespace joy
+#endif // JOYSTICK_CLOCK_H
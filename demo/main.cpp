@@ -6,28 +6,29 @@
 
 // Test main
 int main() {
-    // Start joystick event thread
-    // std::thread joystickThread(readJoystickEvents);
-    bool continueJoystickThread = true;
-
-
     // 3) 시작 시각 기록
     auto t0 = std::chrono::steady_clock::now();
 
-    // std::ref를 사용하여 참조로 전달합니다.
-    //  - readJoystickEvents가 bool&으로 플래그를 받기 때문에, 
-    //    std::ref 없이 값을 전달하면 함수 내부에 복사본이 들어갑니다.
-    //    // 1) 백그라운드 스레드에서 조이스틱을 처리하는 함수(runJoystickThread)를 실행합니다.
-    //  - runJoystickThread가 bool&으로 플래그를 받기 때문에, 
-    //    메인 스레드에서 continueJoystickThread를 false로 바꾸면 스레드가 종료됩니다.
-    //  - ref(continueJoystickThread)를 사용하여 참조로 넘깁니다.
-    std::thread joystickThread(joy::runJoystickThread, std::ref(continueJoystickThread));  
-    // Main thread periodically prints the shared state (head_shared) and accumulative button values
+    // 1) 백그라운드 스레드에서 기본 장치(CONFIG_JOYSTICK_DEVICE)를 처리합니다.
+    //  - joy::JoystickService가 스레드를 만들어 CONFIG_RT_*(우선순위, CPU 고정, 메모리 잠금)를 적용합니다.
+    //  - stop()은 루프가 대기 중이어도 바로 깨워 멈추고, 같은 객체로 다시 start()할 수 있습니다.
+    //  - 예전 방식(std::thread + joy::runJoystickThread(std::atomic<bool>&))도 쓸 수 있습니다.
+    joy::JoystickService joystickService;
+    joystickService.start();
+    std::cout << "Joystick thread: " << joy::formatRealtimeReport(joystickService.threadReport()) << std::endl;
+    // Main thread prints the shared state (head_shared) and accumulative button values
+    // whenever a new state is published. 값이 바뀌지 않는 동안은 잠들어 CPU를 쓰지 않습니다.
+    uint64_t lastSequence = 0;
+    auto lastLatencyPrint = t0;
     while (true) {
         auto now = std::chrono::steady_clock::now();
         double elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - t0).count();
 
-        joy::JoystickState state = joy::getJoystickState();
+        joy::JoystickState state;
+        if (!joy::waitForJoystickUpdate(lastSequence, state, 1000)) {
+            continue;  // 1초 동안 변화 없음
+        }
+        lastSequence = state.sequence;
 
         std::cout << std::setprecision(4);
         std::cout << "----- Shared Joystick State -----" << std::endl;
@@ -47,12 +48,25 @@ int main() {
         // Print accumulative button values for L1/R1 and L2/R2.
         std::cout << "L1/R1 Accumulated: " << state.lr1_accumulated << std::endl;
         std::cout << "L2/R2 Accumulated: " << state.lr2_accumulated << std::endl;
-        std::cout << std::endl;
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        // 1초마다 지연 분포 출력 (입력 → 발행(루프 대기 포함, joydev는 jiffy 해상도), 큐 읽기 → 발행, 발행 → 읽기)
+        if (now - lastLatencyPrint >= std::chrono::seconds(1)) {
+            lastLatencyPrint = now;
+            joy::JoystickLatency latency = joy::getJoystickLatency();
+            std::cout << "Input latency   (us) p50/p99/p99.9/max: " << latency.input.p50 / 1000.0 << " / "
+                      << latency.input.p99 / 1000.0 << " / " << latency.input.p999 / 1000.0 << " / "
+                      << latency.input.max / 1000.0 << std::endl;
+            std::cout << "Process latency (us) p50/p99/p99.9/max: " << latency.process.p50 / 1000.0 << " / "
+                      << latency.process.p99 / 1000.0 << " / " << latency.process.p999 / 1000.0 << " / "
+                      << latency.process.max / 1000.0 << std::endl;
+            std::cout << "Read latency    (us) p50/p99/p99.9/max: " << latency.read.p50 / 1000.0 << " / "
+                      << latency.read.p99 / 1000.0 << " / " << latency.read.p999 / 1000.0 << " / "
+                      << latency.read.max / 1000.0 << std::endl;
+        }
+        std::cout << std::endl;
     }
 
-    // (In practice, join is never reached due to infinite loop.)
-    joystickThread.join();
+    // (In practice, stop is never reached due to infinite loop.)
+    joystickService.stop();
     return 0;
 }
@@ -0,0 +1,131 @@
+#include "fake_joystick.h"
+#include "input_backend.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <vector>
+#include <time.h>
+
+namespace joy {
+
+FakeJoystick::FakeJoystick(const std::string &nodePath) : readFd_(-1), writeFd_(-1), nodePath_(nodePath) {
+}
+
+FakeJoystick::~FakeJoystick() {
+    unplug();
+}
+
+InputBackendFactory FakeJoystick::factory() {
+    return [this](const JoystickConfig &) -> std::unique_ptr<InputBackend> {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (readFd_ < 0) {
+            return nullptr;
+        }
+        int fd = readFd_;
+        readFd_ = -1;   // 소유권은 백엔드로 넘어감
+        return makeJoydevBackend(fd);
+    };
+}
+
+bool FakeJoystick::plug(int axes, int buttons) {
+    unplug();
+
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0) {
+        return false;
+    }
+    shutdown(fds[0], SHUT_WR);   // 장치 쪽은 읽기 전용
+    shutdown(fds[1], SHUT_RD);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        readFd_ = fds[0];
+        writeFd_ = fds[1];
+    }
+
+    std::vector<js_event> init;
+    for (int i = 0; i < axes; ++i) {
+        init.push_back(makeEvent(JS_EVENT_AXIS | JS_EVENT_INIT, static_cast<uint8_t>(i), 0));
+    }
+    for (int i = 0; i < buttons; ++i) {
+        init.push_back(makeEvent(JS_EVENT_BUTTON | JS_EVENT_INIT, static_cast<uint8_t>(i), 0));
+    }
+    if (!write(init.data(), init.size())) {
+        return false;
+    }
+
+    // 초기 상태를 다 써 둔 뒤 노드를 만들어야 핫플러그로 바로 열린 장치가 완전한 패드를 본다
+    if (!nodePath_.empty()) {
+        int node = ::open(nodePath_.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+        if (node < 0) {
+            return false;
+        }
+        ::close(node);
+    }
+    return true;
+}
+
+void FakeJoystick::unplug() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (writeFd_ >= 0) {
+        ::close(writeFd_);
+        writeFd_ = -1;
+    }
+    if (readFd_ >= 0) {
+        ::close(readFd_);   // 장치가 가져가기 전에 뽑힘
+        readFd_ = -1;
+    }
+    if (!nodePath_.empty()) {
+        ::unlink(nodePath_.c_str());
+    }
+}
+
+bool FakeJoystick::isPlugged() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writeFd_ >= 0;
+}
+
+bool FakeJoystick::axis(int number, int16_t value) {
+    js_event event = makeEvent(JS_EVENT_AXIS, static_cast<uint8_t>(number), value);
+    return write(&event, 1);
+}
+
+bool FakeJoystick::button(int number, bool pressed) {
+    js_event event = makeEvent(JS_EVENT_BUTTON, static_cast<uint8_t>(number), pressed ? 1 : 0);
+    return write(&event, 1);
+}
+
+// 장치 쪽 read가 이벤트 중간에서 끊기지 않도록 EVENTS_PER_SEND개 단위로 보냄
+bool FakeJoystick::write(const js_event *events, size_t count) {
+    constexpr size_t EVENTS_PER_SEND = 64;   // JoydevBackend의 read 버퍼와 같은 크기
+    const char *data = reinterpret_cast<const char *>(events);
+    size_t remaining = count * sizeof(js_event);
+    while (remaining > 0) {
+        size_t chunk = std::min(remaining, EVENTS_PER_SEND * sizeof(js_event));
+        ssize_t written = send(writeFd_, data, chunk, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;   // 뽑혔거나 장치 쪽이 닫힘 (EBADF / EPIPE)
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+js_event FakeJoystick::makeEvent(uint8_t type, uint8_t number, int16_t value) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    js_event event;
+    event.time   = static_cast<uint32_t>(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+    event.value  = value;
+    event.type   = type;
+    event.number = number;
+    return event;
+}
+
+}  // namespace joy
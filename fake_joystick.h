@@ -0,0 +1,73 @@
+#ifndef JOYSTICK_FAKE_JOYSTICK_H
+#define JOYSTICK_FAKE_JOYSTICK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "joystick.h"
+
+namespace joy {
+
+/**
+ * @brief FakeJoystick
+ *
+ * 게임패드 없이 실제 파이프라인을 돌리기 위한 가짜 joydev 장치.
+ * socketpair(AF_UNIX, SOCK_STREAM)의 한쪽을 JoystickDevice에 넘기고(makeJoydevBackend),
+ * 다른 쪽에 js_event 바이트를 써 넣습니다. 장치 입장에서는 /dev/input/js*와 똑같이
+ * non-blocking read / epoll로 읽히므로 폴링·이벤트 구동 루프, Kill Switch, 초기화 게이팅,
+ * 끊김/재연결 경로를 그대로 탑니다.
+ *
+ *   FakeJoystick pad;
+ *   device.setBackendFactory(pad.factory());   // run 전에
+ *   pad.plug();                                // 연결 (다음 open/재연결에서 잡힘)
+ *   pad.button(config.buttonStart, true);
+ *   pad.axis(1, -32767);
+ *   pad.unplug();                              // EOF → 디스커넥트
+ *
+ * nodePath를 주면 plug()가 그 경로에 빈 파일을 만들고 unplug()가 지우므로, 장치 설정의 경로를
+ * 같은 절대 경로로 두면 JoystickManager의 핫플러그 감시(inotify)가 실제 /dev/input처럼 꽂힘을 알아챕니다.
+ * 경로가 없으면 재연결은 1초 간격 시도로만 잡힙니다.
+ *
+ * 쓰기 API는 한 스레드(테스트/벤치 스레드)에서만 호출합니다. 소켓 버퍼가 가득 차면
+ * 장치가 읽어 갈 때까지 쓰기가 블록되므로 이벤트 폭주에서도 이벤트를 잃지 않습니다.
+ * 장치 쪽이 이미 닫혔으면 SIGPIPE 없이 false를 돌려줍니다.
+ */
+class FakeJoystick {
+public:
+    explicit FakeJoystick(const std::string &nodePath = std::string());
+    ~FakeJoystick();
+
+    FakeJoystick(const FakeJoystick &) = delete;
+    FakeJoystick &operator=(const FakeJoystick &) = delete;
+
+    // JoystickDevice::setBackendFactory에 넘길 factory. 꽂혀 있지 않으면 "장치 없음"
+    InputBackendFactory factory();
+
+    /**
+     * @brief 새 소켓 쌍으로 장치를 꽂음
+     *
+     * 실제 joydev처럼 JS_EVENT_INIT 이벤트로 모든 축(0)과 버튼(0)의 초기 상태를 먼저 써 둔 뒤
+     * nodePath가 있으면 노드 파일을 만듭니다. 이미 꽂혀 있으면 먼저 뽑습니다.
+     */
+    bool plug(int axes = MAX_AXES, int buttons = MAX_BUTTONS);
+    void unplug();                          // 테스트 쪽 끝을 닫아 장치 쪽 read가 EOF를 받게 하고 노드 파일을 지움
+    bool isPlugged() const;
+
+    bool axis(int number, int16_t value);
+    bool button(int number, bool pressed);
+    bool write(const js_event *events, size_t count);   // 여러 이벤트를 한 번에 (버스트)
+
+    // js_event 하나 만들기 (time은 CLOCK_MONOTONIC ms)
+    static js_event makeEvent(uint8_t type, uint8_t number, int16_t value);
+
+private:
+    mutable std::mutex mutex_;   // readFd_ 인계 (factory는 작업 스레드에서 불림)
+    int readFd_;                 // 아직 장치가 가져가지 않은 읽기 끝 (-1: 없음)
+    int writeFd_;                // 테스트 쪽 끝 (-1: 뽑힘)
+    std::string nodePath_;       // 꽂혀 있는 동안 만들어 두는 노드 파일 (비어 있으면 없음)
+};
+
+}  // namespace joy
+#endif // JOYSTICK_FAKE_JOYSTICK_H
@@ -0,0 +1,917 @@
+#include "input_backend.h"
+#include "recorder.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/timerfd.h>
+#include <linux/input.h>
+#include <climits>
+#include <string>
+#include <vector>
+#include <time.h>
+
+namespace joy {
+
+static int64_t monotonicNowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+
+// 버튼 값을 바꾸고, 실제로 바뀌었으면 edge 기록
+static void setButton(int &level, int button, int value, int64_t timeNs, ButtonEdgeQueue *edges) {
+    if (level != value && edges) {
+        edges->push(ButtonEdge{timeNs, static_cast<uint32_t>(button), value ? 1u : 0u});
+    }
+    level = value;
+}
+
+// 한 번의 read()로 가져올 최대 이벤트 개수.
+// 큐에 이보다 많이 쌓여 있으면 EAGAIN이 날 때까지 반복해서 읽는다.
+static constexpr int EVENT_BATCH_SIZE = 64;
+
+// ─────────────────────────────────────────────────────────────────────────────
+// joydev (/dev/input/js*)
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @brief JsEventClock
+ *
+ * js_event.time(jiffies 기반 ms, 32비트에서 한 바퀴 돎)을 CLOCK_MONOTONIC ns로 옮깁니다.
+ * 두 시계의 차이(offset)는 알 수 없으므로, 읽은 시각 - 이벤트 시각의 최솟값으로 추정합니다.
+ * 이벤트는 항상 읽기 전에 일어나므로 이 값은 offset보다 작아지지 않고, 큐에 오래 머물지 않은
+ * 이벤트가 하나라도 있으면 offset에 가까워집니다. 두 시계가 조금씩 어긋나는 것(NTP 보정)을
+ * 따라가도록 최솟값은 OFFSET_WINDOW_NS 창 두 개(직전 창 + 현재 창)에서만 구합니다.
+ *
+ * 이벤트 시각은 ms로 잘린 값이므로 그 ms 구간의 가운데(+0.5ms)로 잡고, 읽은 시각을 넘지 않게 자릅니다.
+ * 해상도는 커널 tick(jiffy, 1~10ms)이므로 폴링 주기 대기처럼 ms 단위 지연을 보는 용도입니다.
+ */
+class JsEventClock {
+public:
+    JsEventClock() : started_(false), lastMs_(0), extendedMs_(0), windowStartNs_(0),
+                     currentMin_(INT64_MAX), previousMin_(INT64_MAX) {}
+
+    int64_t toMonotonicNs(uint32_t timeMs, int64_t readTimeNs) {
+        if (!started_) {
+            started_ = true;
+            extendedMs_ = timeMs;
+            windowStartNs_ = readTimeNs;
+        } else {
+            extendedMs_ += static_cast<int32_t>(timeMs - lastMs_);   // wrap 처리 (부호 있는 차이)
+        }
+        lastMs_ = timeMs;
+
+        int64_t candidate = readTimeNs - extendedMs_ * 1000000LL;
+        if (readTimeNs - windowStartNs_ >= OFFSET_WINDOW_NS) {
+            previousMin_ = currentMin_;
+            currentMin_ = candidate;
+            windowStartNs_ = readTimeNs;
+        } else if (candidate < currentMin_) {
+            currentMin_ = candidate;
+        }
+        int64_t offset = std::min(previousMin_, currentMin_);
+        return std::min<int64_t>(extendedMs_ * 1000000LL + offset + 500000LL, readTimeNs);
+    }
+
+private:
+    static constexpr int64_t OFFSET_WINDOW_NS = 10LL * 1000000000LL;
+
+    bool started_;
+    uint32_t lastMs_;
+    int64_t extendedMs_;      // wrap을 풀어 64비트로 늘린 이벤트 시각 (ms)
+    int64_t windowStartNs_;
+    int64_t currentMin_;      // 현재 창의 읽은 시각 - 이벤트 시각 최솟값 (ns)
+    int64_t previousMin_;     // 직전 창의 최솟값
+};
+
+/**
+ * @brief JoydevBackend
+ *
+ * 기존 joydev API(js_event). 커널이 축 값을 이미 ±32767로 보정해 줍니다.
+ * 이벤트 타임스탬프는 jiffies 기반 ms 값이라 JsEventClock으로 CLOCK_MONOTONIC에 맞춰
+ * eventTimeNs로 넘깁니다 (해상도 1 jiffy). 버튼 edge와 녹화에는 읽은 시각을 씁니다.
+ */
+class JoydevBackend : public InputBackend {
+public:
+    JoydevBackend() : fd_(-1), adopted_(false) {}
+    explicit JoydevBackend(int adoptedFd) : fd_(adoptedFd), adopted_(true) {}
+    ~JoydevBackend() override { close(); }
+
+    const char *name() const override { return adopted_ ? "joydev-fd" : "joydev"; }
+
+    bool open(const char *devicePath) override {
+        if (adopted_) {
+            // 넘겨받은 fd를 그대로 사용. 한 번 닫힌 뒤에는 다시 열 수 없음
+            return fd_ >= 0 && fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK) == 0;
+        }
+        fd_ = ::open(devicePath, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        return fd_ >= 0;
+    }
+
+    void close() override {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd() const override { return fd_; }
+
+    bool drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+               InputDrainResult &result) override;
+
+private:
+    int fd_;
+    bool adopted_;   // makeJoydevBackend(fd)로 만든 경우
+    JsEventClock eventClock_;
+};
+
+/**
+ * @brief applyEvent
+ *
+ * js_event 하나를 localState에 반영합니다.
+ *  - 축 이벤트: raw 값을 localState.axes[index]에 대입
+ *  - 버튼 이벤트: state 값을 localState.buttons[index]에 대입 (값이 바뀌면 edge 기록)
+ * 범위를 벗어난 인덱스의 이벤트는 무시합니다.
+ */
+static void applyEvent(const js_event &event, JoystickState &localState, int64_t timeNs, ButtonEdgeQueue *edges,
+                       InputRecorder *recorder) {
+    unsigned char type = event.type & ~JS_EVENT_INIT;
+    if (type == JS_EVENT_AXIS) {
+        int axis_index = event.number;
+        if (axis_index < MAX_AXES) {
+            // Store the raw value (as float) from the event.
+            localState.axes[axis_index] = static_cast<float>(event.value);
+            if (recorder) {
+                recorder->recordInput(timeNs, RecordInputKind::Axis, axis_index, localState.axes[axis_index]);
+            }
+#ifdef CONFIG_DATA_PRINT
+            std::cout << "Axis " << axis_index
+                      << " raw: " << event.value << std::endl;
+#endif
+        }
+    } else if (type == JS_EVENT_BUTTON) {
+        int button_index = event.number;
+        if (button_index < MAX_BUTTONS) {
+            setButton(localState.buttons[button_index], button_index, event.value ? 1 : 0, timeNs, edges);
+            if (recorder) {
+                recorder->recordInput(timeNs, RecordInputKind::Button, button_index, event.value ? 1.0f : 0.0f);
+            }
+#ifdef CONFIG_DATA_PRINT
+            std::cout << "Button " << button_index
+                      << " state: " << event.value << std::endl;
+#endif
+        }
+    }
+}
+
+/**
+ * @brief JoydevBackend::drain
+ *
+ * 커널 큐에 쌓인 js_event를 EAGAIN이 날 때까지 EVENT_BATCH_SIZE 단위로 모두 읽어
+ * 순서대로 localState에 반영합니다. 한 틱에 이벤트를 하나만 읽으면 축이 많은 패드에서
+ * 큐가 밀려 수백 ms 지난 스틱 값으로 제어하게 되므로, 매 틱마다 큐를 비웁니다.
+ *
+ * 한 배치 안에서 Kill Switch가 눌렸다 떼어지면 localState에는 뗀 상태만 남으므로,
+ * 눌림 이벤트를 봤는지 여부를 result.killPressed로 따로 알려줍니다.
+ */
+bool JoydevBackend::drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+                          InputDrainResult &result) {
+    js_event events[EVENT_BATCH_SIZE];
+    result = {};
+
+    while (true) {
+        ssize_t bytes = read(fd_, events, sizeof(events));
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EAGAIN: 큐가 비었음. 그 외 에러는 디스커넥트로 간주.
+            return errno == EAGAIN;
+        }
+        if (bytes == 0) {
+            return false;  // EOF: 디바이스가 사라짐
+        }
+
+        int count = static_cast<int>(bytes / sizeof(js_event));
+        int64_t readTimeNs = monotonicNowNs();
+        for (int i = 0; i < count; ++i) {
+            result.eventTimeNs = eventClock_.toMonotonicNs(events[i].time, readTimeNs);
+            applyEvent(events[i], localState, readTimeNs, edges, recorder_);
+            if ((events[i].type & ~JS_EVENT_INIT) == JS_EVENT_BUTTON &&
+                events[i].number == killButton && events[i].value) {
+                result.killPressed = true;
+            }
+        }
+        result.events += count;
+        if (recorder_ && count > 0) {
+            recorder_->recordSync(readTimeNs);  // joydev는 read 한 번이 곧 반영 단위
+        }
+
+        // 버퍼를 다 채우지 못했다면 큐가 이미 비었으므로 EAGAIN 확인용 read는 생략
+        if (bytes < static_cast<ssize_t>(sizeof(events))) {
+            return true;
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// evdev (/dev/input/event*)
+// ─────────────────────────────────────────────────────────────────────────────
+
+static bool testBit(const unsigned long *bits, int bit) {
+    constexpr int BITS_PER_LONG = sizeof(unsigned long) * 8;
+    return (bits[bit / BITS_PER_LONG] >> (bit % BITS_PER_LONG)) & 1UL;
+}
+
+/**
+ * @brief EvdevBackend
+ *
+ * evdev API(input_event). joydev와 비교해
+ *  - 축마다 EVIOCGABS로 읽은 min/max/flat으로 ±32767 범위로 직접 환산하고
+ *    (fuzz는 커널 입력 코어가 이벤트 단계에서 이미 적용),
+ *  - 이벤트를 SYN_REPORT 단위 프레임으로 모아 한 번에 반영해 스틱의 X/Y가 서로 다른
+ *    샘플에서 섞이지 않으며,
+ *  - EVIOCSCLOCKID로 CLOCK_MONOTONIC 타임스탬프를 받아 입력 지연을 잴 수 있습니다.
+ *
+ * 축/버튼 번호는 joydev 드라이버와 같은 규칙으로 매겨 js* 장치와 같은 인덱스가 나옵니다.
+ * (축: ABS 코드 순서, 버튼: BTN_JOYSTICK ~ KEY_MAX 다음 BTN_MISC ~ BTN_JOYSTICK-1)
+ */
+class EvdevBackend : public InputBackend {
+public:
+    EvdevBackend() : fd_(-1), monotonic_(false), dropping_(false), pendingCommit_(false),
+                     pendingKill_(false), pendingEvents_(0), frame_() {}
+    ~EvdevBackend() override { close(); }
+
+    const char *name() const override { return "evdev"; }
+
+    bool open(const char *devicePath) override;
+
+    void close() override {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    int fd() const override { return fd_; }
+
+    bool drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+               InputDrainResult &result) override;
+
+private:
+    struct AbsRange {
+        int32_t min, max, flat, fuzz;
+    };
+
+    float scaleAbs(int axis, int32_t value) const;
+    void syncFrame(int64_t timeNs, ButtonEdgeQueue *edges);  // ioctl로 전체 축/버튼 상태를 frame_에 다시 채움
+    void commitFrame(JoystickState &localState, InputDrainResult &result, int64_t timeNs);
+
+    int fd_;
+    bool monotonic_;                         // 타임스탬프가 CLOCK_MONOTONIC인지
+    bool dropping_;                          // SYN_DROPPED 이후 다음 SYN_REPORT까지 이벤트 무시
+    bool pendingCommit_;                     // open/재동기화 직후의 frame_를 다음 drain에서 반영
+    bool pendingKill_;
+    uint32_t pendingEvents_;
+    int16_t absToAxis_[ABS_CNT];             // ABS 코드 → 축 인덱스 (-1: 사용 안 함)
+    int16_t keyToButton_[KEY_CNT];           // KEY 코드 → 버튼 인덱스 (-1: 사용 안 함)
+    int axisToAbs_[MAX_AXES];
+    int buttonToKey_[MAX_BUTTONS];
+    int axisCount_;
+    int buttonCount_;
+    AbsRange ranges_[MAX_AXES];
+    JoystickState frame_;                    // SYN_REPORT 전까지 모으는 중인 프레임
+};
+
+bool EvdevBackend::open(const char *devicePath) {
+    fd_ = ::open(devicePath, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    int version = 0;
+    if (ioctl(fd_, EVIOCGVERSION, &version) < 0) {
+        std::cerr << "[JoyStick] " << devicePath << " is not an evdev device" << std::endl;
+        close();
+        return false;
+    }
+    int clockId = CLOCK_MONOTONIC;
+    monotonic_ = ioctl(fd_, EVIOCSCLOCKID, &clockId) == 0;
+
+    constexpr int BITS_PER_LONG = sizeof(unsigned long) * 8;
+    unsigned long absBits[(ABS_CNT + BITS_PER_LONG - 1) / BITS_PER_LONG] = {};
+    unsigned long keyBits[(KEY_CNT + BITS_PER_LONG - 1) / BITS_PER_LONG] = {};
+    ioctl(fd_, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits);
+    ioctl(fd_, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits);
+
+    std::fill(absToAxis_, absToAxis_ + ABS_CNT, static_cast<int16_t>(-1));
+    std::fill(keyToButton_, keyToButton_ + KEY_CNT, static_cast<int16_t>(-1));
+    axisCount_ = 0;
+    for (int code = 0; code < ABS_CNT && axisCount_ < MAX_AXES; ++code) {
+        if (!testBit(absBits, code)) {
+            continue;
+        }
+        struct input_absinfo info = {};
+        ioctl(fd_, EVIOCGABS(code), &info);
+        ranges_[axisCount_] = {info.minimum, info.maximum, info.flat, info.fuzz};
+        axisToAbs_[axisCount_] = code;
+        absToAxis_[code] = static_cast<int16_t>(axisCount_++);
+    }
+    buttonCount_ = 0;
+    auto mapKey = [&](int code) {
+        if (buttonCount_ < MAX_BUTTONS && testBit(keyBits, code)) {
+            buttonToKey_[buttonCount_] = code;
+            keyToButton_[code] = static_cast<int16_t>(buttonCount_++);
+        }
+    };
+    for (int code = BTN_JOYSTICK; code < KEY_CNT; ++code) {
+        mapKey(code);
+    }
+    for (int code = BTN_MISC; code < BTN_JOYSTICK; ++code) {
+        mapKey(code);
+    }
+
+    dropping_ = false;
+    pendingKill_ = false;
+    pendingEvents_ = 0;
+    frame_ = {};
+    pendingCommit_ = true;  // 전체 상태는 첫 drain에서 읽는다 (edge 큐가 그때 주어짐)
+    return true;
+}
+
+/**
+ * @brief scaleAbs
+ *
+ * evdev 축 값을 joydev와 같은 방식으로 ±32767에 매핑합니다.
+ * 중심 ± flat 안은 0, 그 밖은 [flat, 반폭]을 [0, 32767]로 선형 매핑합니다.
+ */
+float EvdevBackend::scaleAbs(int axis, int32_t value) const {
+    const AbsRange &range = ranges_[axis];
+    if (range.max <= range.min) {
+        return static_cast<float>(value);
+    }
+    float center = 0.5f * (static_cast<float>(range.min) + static_cast<float>(range.max));
+    float halfRange = 0.5f * (static_cast<float>(range.max) - static_cast<float>(range.min));
+    float flat = std::min(static_cast<float>(std::max(range.flat, 0)), halfRange * 0.5f);
+    float offset = static_cast<float>(value) - center;
+    float magnitude = std::fabs(offset) - flat;
+    if (magnitude <= 0.0f) {
+        return 0.0f;
+    }
+    float scaled = std::min(magnitude / (halfRange - flat), 1.0f) * RAW_AXIS_MAX_POS;
+    return offset >= 0.0f ? scaled : -scaled;
+}
+
+void EvdevBackend::syncFrame(int64_t timeNs, ButtonEdgeQueue *edges) {
+    for (int i = 0; i < axisCount_; ++i) {
+        struct input_absinfo info = {};
+        if (ioctl(fd_, EVIOCGABS(axisToAbs_[i]), &info) == 0) {
+            frame_.axes[i] = scaleAbs(i, info.value);
+            if (recorder_) {
+                recorder_->recordInput(timeNs, RecordInputKind::Axis, i, frame_.axes[i]);
+            }
+        }
+    }
+    constexpr int BITS_PER_LONG = sizeof(unsigned long) * 8;
+    unsigned long keyState[(KEY_CNT + BITS_PER_LONG - 1) / BITS_PER_LONG] = {};
+    if (ioctl(fd_, EVIOCGKEY(sizeof(keyState)), keyState) >= 0) {
+        for (int i = 0; i < buttonCount_; ++i) {
+            setButton(frame_.buttons[i], i, testBit(keyState, buttonToKey_[i]) ? 1 : 0, timeNs, edges);
+            if (recorder_) {
+                recorder_->recordInput(timeNs, RecordInputKind::Button, i, static_cast<float>(frame_.buttons[i]));
+            }
+        }
+    }
+}
+
+// 완성된 프레임을 localState에 한 번에 반영
+void EvdevBackend::commitFrame(JoystickState &localState, InputDrainResult &result, int64_t timeNs) {
+    std::copy(frame_.axes, frame_.axes + MAX_AXES, localState.axes);
+    std::copy(frame_.buttons, frame_.buttons + MAX_BUTTONS, localState.buttons);
+    result.events += pendingEvents_;
+    result.killPressed = result.killPressed || pendingKill_;
+    if (timeNs > 0) {
+        result.eventTimeNs = timeNs;
+    }
+    pendingEvents_ = 0;
+    pendingKill_ = false;
+    if (recorder_) {
+        recorder_->recordSync(timeNs > 0 ? timeNs : monotonicNowNs());
+    }
+#ifdef CONFIG_DATA_PRINT
+    std::cout << "Frame axes:";
+    for (int i = 0; i < axisCount_; ++i) {
+        std::cout << ' ' << frame_.axes[i];
+    }
+    std::cout << std::endl;
+#endif
+}
+
+/**
+ * @brief EvdevBackend::drain
+ *
+ * input_event를 EAGAIN이 날 때까지 읽어 frame_에 모으고, SYN_REPORT를 만날 때마다
+ * 프레임 전체를 localState에 반영합니다. 마지막 SYN_REPORT 뒤의 미완성 프레임은
+ * 다음 drain까지 frame_에 남습니다.
+ * SYN_DROPPED(커널 버퍼 넘침)를 받으면 다음 SYN_REPORT까지 버리고 ioctl로 전체 상태를 다시 읽습니다.
+ */
+bool EvdevBackend::drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+                         InputDrainResult &result) {
+    struct input_event events[EVENT_BATCH_SIZE];
+    result = {};
+    if (pendingCommit_) {
+        pendingCommit_ = false;
+        syncFrame(monotonicNowNs(), edges);
+        commitFrame(localState, result, 0);
+    }
+
+    while (true) {
+        ssize_t bytes = read(fd_, events, sizeof(events));
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EAGAIN: 큐가 비었음. ENODEV 등 그 외 에러는 디스커넥트로 간주.
+            return errno == EAGAIN;
+        }
+        if (bytes == 0) {
+            return false;
+        }
+
+        int count = static_cast<int>(bytes / sizeof(struct input_event));
+        for (int i = 0; i < count; ++i) {
+            const struct input_event &ev = events[i];
+            int64_t timeNs = 0;
+            if (monotonic_) {
+                timeNs = static_cast<int64_t>(ev.input_event_sec) * 1000000000LL +
+                         static_cast<int64_t>(ev.input_event_usec) * 1000LL;
+            }
+            if (ev.type == EV_SYN) {
+                if (ev.code == SYN_DROPPED) {
+                    dropping_ = true;
+                } else if (ev.code == SYN_REPORT) {
+                    if (dropping_) {
+                        dropping_ = false;
+                        syncFrame(timeNs > 0 ? timeNs : monotonicNowNs(), edges);
+                    }
+                    commitFrame(localState, result, timeNs);
+                }
+                continue;
+            }
+            if (dropping_) {
+                continue;
+            }
+            if (ev.type == EV_ABS && ev.code < ABS_CNT && absToAxis_[ev.code] >= 0) {
+                int axis = absToAxis_[ev.code];
+                frame_.axes[axis] = scaleAbs(axis, ev.value);
+                if (recorder_) {
+                    recorder_->recordInput(timeNs > 0 ? timeNs : monotonicNowNs(), RecordInputKind::Axis,
+                                           axis, frame_.axes[axis]);
+                }
+                ++pendingEvents_;
+            } else if (ev.type == EV_KEY && ev.code < KEY_CNT && keyToButton_[ev.code] >= 0) {
+                int button = keyToButton_[ev.code];
+                int64_t buttonTimeNs = timeNs > 0 ? timeNs : monotonicNowNs();
+                setButton(frame_.buttons[button], button, ev.value ? 1 : 0, buttonTimeNs, edges);
+                if (recorder_) {
+                    recorder_->recordInput(buttonTimeNs, RecordInputKind::Button, button, ev.value ? 1.0f : 0.0f);
+                }
+                if (button == killButton && ev.value) {
+                    pendingKill_ = true;
+                }
+                ++pendingEvents_;
+            }
+        }
+
+        if (bytes < static_cast<ssize_t>(sizeof(events))) {
+            return true;
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// replay (*.joyrec)
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @brief ReplayBackend
+ *
+ * InputRecorder로 녹화한 파일을 mmap해 Input/Sync 레코드를 녹화 당시와 같은 시간 간격으로
+ * 다시 내보냅니다. 실제 장치와 똑같이 drain → updateSharedState / updateAccumulators를 거치므로
+ * 운용 중에 생긴 문제를 같은 파이프라인으로 재현할 수 있습니다.
+ * 파일 전체를 읽어 들이지 않으므로 몇 시간짜리 녹화도 메모리 부담 없이 재생합니다.
+ *
+ * fd()는 다음 레코드 시각에 맞춰 둔 timerfd라 이벤트 구동 루프에서도 제때 깨어납니다.
+ * 파일 끝에 닿으면 장치가 끊어진 것으로 보고하며, 재연결 시 처음부터 다시 재생합니다.
+ */
+class ReplayBackend : public InputBackend {
+public:
+    ReplayBackend() : timerFd_(-1), data_(nullptr), size_(0), pos_(0), firstTimeNs_(0), startNs_(0),
+                      finished_(false), pendingKill_(false), pendingEvents_(0), frame_() {}
+    ~ReplayBackend() override { close(); }
+
+    const char *name() const override { return "replay"; }
+
+    bool open(const char *devicePath) override;
+
+    void close() override {
+        if (data_) {
+            munmap(const_cast<unsigned char *>(data_), size_);
+            data_ = nullptr;
+        }
+        if (timerFd_ >= 0) {
+            ::close(timerFd_);
+            timerFd_ = -1;
+        }
+    }
+
+    int fd() const override { return timerFd_; }
+
+    bool drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+               InputDrainResult &result) override;
+
+private:
+    void armTimer(int64_t dueNs);
+
+    int timerFd_;
+    const unsigned char *data_;
+    size_t size_;
+    size_t pos_;                 // 다음 레코드 위치
+    int64_t firstTimeNs_;        // 녹화 파일의 첫 레코드 시각
+    int64_t startNs_;            // 재생을 시작한 시각
+    bool finished_;
+    bool pendingKill_;
+    uint32_t pendingEvents_;
+    JoystickState frame_;
+};
+
+bool ReplayBackend::open(const char *devicePath) {
+    int fd = ::open(devicePath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(sizeof(RecordFileHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const unsigned char *>(mapped);
+    size_ = static_cast<size_t>(st.st_size);
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+
+    RecordFileHeader header;
+    std::memcpy(&header, data_, sizeof(header));
+    if (std::memcmp(header.magic, RECORD_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != RECORD_VERSION || header.headerSize < sizeof(RecordFileHeader) ||
+        header.maxAxes != MAX_AXES || header.maxButtons != MAX_BUTTONS) {
+        std::cerr << "[JoyStick] " << devicePath << " is not a compatible recording" << std::endl;
+        close();
+        return false;
+    }
+
+    timerFd_ = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timerFd_ < 0) {
+        close();
+        return false;
+    }
+
+    pos_ = header.headerSize;
+    firstTimeNs_ = 0;
+    if (pos_ + sizeof(RecordHeader) <= size_) {
+        RecordHeader first;
+        std::memcpy(&first, data_ + pos_, sizeof(first));
+        firstTimeNs_ = first.timeNs;
+    }
+    startNs_ = monotonicNowNs();
+    finished_ = false;
+    pendingKill_ = false;
+    pendingEvents_ = 0;
+    frame_ = {};
+    armTimer(startNs_);
+    return true;
+}
+
+void ReplayBackend::armTimer(int64_t dueNs) {
+    struct itimerspec spec = {};
+    if (dueNs <= 0) {
+        dueNs = 1;  // 0은 타이머 해제이므로 "지금"으로 대체
+    }
+    spec.it_value.tv_sec  = static_cast<time_t>(dueNs / 1000000000LL);
+    spec.it_value.tv_nsec = static_cast<long>(dueNs % 1000000000LL);
+    timerfd_settime(timerFd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+/**
+ * @brief ReplayBackend::drain
+ *
+ * 재생 시각이 된 레코드를 순서대로 처리합니다.
+ *  - Input: frame_에 반영 (버튼 edge, Kill Switch 눌림도 실제 장치와 같게 기록)
+ *  - Sync : frame_를 localState에 한꺼번에 반영
+ *  - Config / State: 건너뜀
+ * 다음 레코드가 아직 이르면 그 시각으로 timerfd를 맞추고 반환합니다.
+ */
+bool ReplayBackend::drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+                          InputDrainResult &result) {
+    result = {};
+    uint64_t expirations;
+    while (read(timerFd_, &expirations, sizeof(expirations)) > 0) {
+    }
+    if (finished_) {
+        return false;  // 마지막 프레임은 직전 틱에 반영됨
+    }
+
+    int64_t now = monotonicNowNs();
+    while (pos_ + sizeof(RecordHeader) <= size_) {
+        RecordHeader header;
+        std::memcpy(&header, data_ + pos_, sizeof(header));
+        if (pos_ + sizeof(header) + header.size > size_) {
+            break;  // 녹화 도중 끊겨 잘린 레코드
+        }
+        int64_t dueNs = startNs_ + (header.timeNs - firstTimeNs_);
+        if (dueNs > now) {
+            armTimer(dueNs);
+            return true;
+        }
+
+        const unsigned char *payload = data_ + pos_ + sizeof(header);
+        RecordType type = static_cast<RecordType>(header.type);
+        if (type == RecordType::Input && header.size == sizeof(RecordInput)) {
+            RecordInput input;
+            std::memcpy(&input, payload, sizeof(input));
+            if (input.kind == static_cast<uint16_t>(RecordInputKind::Axis) && input.index < MAX_AXES) {
+                frame_.axes[input.index] = input.value;
+                ++pendingEvents_;
+            } else if (input.kind == static_cast<uint16_t>(RecordInputKind::Button) && input.index < MAX_BUTTONS) {
+                int value = input.value != 0.0f ? 1 : 0;
+                setButton(frame_.buttons[input.index], input.index, value, dueNs, edges);
+                if (input.index == killButton && value) {
+                    pendingKill_ = true;
+                }
+                ++pendingEvents_;
+            }
+            if (recorder_) {
+                recorder_->recordInput(dueNs, static_cast<RecordInputKind>(input.kind), input.index, input.value);
+            }
+        } else if (type == RecordType::Sync) {
+            std::copy(frame_.axes, frame_.axes + MAX_AXES, localState.axes);
+            std::copy(frame_.buttons, frame_.buttons + MAX_BUTTONS, localState.buttons);
+            result.events += pendingEvents_;
+            result.killPressed = result.killPressed || pendingKill_;
+            result.eventTimeNs = dueNs;
+            pendingEvents_ = 0;
+            pendingKill_ = false;
+            if (recorder_) {
+                recorder_->recordSync(dueNs);
+            }
+        }
+        pos_ += sizeof(header) + header.size;
+    }
+
+    finished_ = true;
+    armTimer(now);  // 다음 drain에서 끝을 알리도록 바로 깨움
+    return true;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// HotplugWatcher
+// ─────────────────────────────────────────────────────────────────────────────
+
+HotplugWatcher::HotplugWatcher() : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) {
+}
+
+HotplugWatcher::~HotplugWatcher() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool HotplugWatcher::watchParentOf(const char *devicePath) {
+    const char *slash = std::strrchr(devicePath, '/');
+    if (fd_ < 0 || devicePath[0] != '/' || slash == nullptr) {
+        return false;
+    }
+    std::string dir(devicePath, slash == devicePath ? 1 : static_cast<size_t>(slash - devicePath));
+    // 같은 디렉터리면 inotify가 같은 watch를 돌려주므로 중복 등록되지 않는다
+    int wd = inotify_add_watch(fd_, dir.c_str(), IN_CREATE | IN_MOVED_TO | IN_ATTRIB);
+    if (wd < 0) {
+        return false;
+    }
+    for (const auto &watch : watches_) {
+        if (watch.first == wd) {
+            return true;
+        }
+    }
+    watches_.emplace_back(wd, dir);
+    return true;
+}
+
+int HotplugWatcher::fd() const {
+    return fd_;
+}
+
+bool HotplugWatcher::readChanges(const NodeCallback &onNode) {
+    if (fd_ < 0) {
+        return false;
+    }
+    alignas(struct inotify_event) char buffer[16 * (sizeof(struct inotify_event) + NAME_MAX + 1)];
+    static const std::string noDir;
+    bool changed = false;
+    for (;;) {
+        ssize_t bytes = read(fd_, buffer, sizeof(buffer));
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes <= 0) {
+            return changed;  // EAGAIN: 모두 비움
+        }
+        changed = true;
+        for (ssize_t offset = 0; offset < bytes;) {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(struct inotify_event) + event->len);
+            if (event->mask & IN_Q_OVERFLOW) {
+                onNode(noDir, nullptr);
+                continue;
+            }
+            if (event->len == 0) {
+                continue;  // 디렉터리 자체의 변화
+            }
+            for (const auto &watch : watches_) {
+                if (watch.first == event->wd) {
+                    onNode(watch.second, event->name);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 장치 식별 / 탐색
+// ─────────────────────────────────────────────────────────────────────────────
+
+// Auto를 경로 이름으로 실제 백엔드 종류로 바꿈
+static InputBackendType resolveBackendType(InputBackendType type, const char *devicePath) {
+    if (type != InputBackendType::Auto) {
+        return type;
+    }
+    const char *slash = std::strrchr(devicePath, '/');
+    const char *base = slash ? slash + 1 : devicePath;
+    size_t length = std::strlen(base);
+    if (length > 7 && std::strcmp(base + length - 7, ".joyrec") == 0) {
+        return InputBackendType::Replay;
+    }
+    return std::strncmp(base, "event", 5) == 0 ? InputBackendType::Evdev : InputBackendType::Joydev;
+}
+
+// sysfs의 16진수 ID 파일 (예: .../id/vendor의 "054c")
+static uint16_t readSysfsHex(const std::string &path) {
+    std::ifstream file(path);
+    unsigned int value = 0;
+    if (!(file >> std::hex >> value)) {
+        return 0;
+    }
+    return static_cast<uint16_t>(value);
+}
+
+bool readInputDeviceIdentity(const char *devicePath, InputDeviceIdentity &identity) {
+    identity = {};
+    int fd = ::open(devicePath, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    // joydev 노드인지 evdev 노드인지는 ioctl로 가린다 (by-id 심볼릭 링크 등 이름으로는 알 수 없음)
+    bool ok = true;
+    struct input_id id = {};
+    if (ioctl(fd, JSIOCGNAME(sizeof(identity.name) - 1), identity.name) >= 0) {
+        // joydev는 ID를 주지 않으므로 문자 장치 번호로 sysfs의 부모 입력 장치를 찾는다
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISCHR(st.st_mode)) {
+            std::string sysfs = "/sys/dev/char/" + std::to_string(major(st.st_rdev)) + ":" +
+                                std::to_string(minor(st.st_rdev)) + "/device/id/";
+            identity.vendor  = readSysfsHex(sysfs + "vendor");
+            identity.product = readSysfsHex(sysfs + "product");
+        }
+    } else if (ioctl(fd, EVIOCGNAME(sizeof(identity.name) - 1), identity.name) >= 0) {
+        if (ioctl(fd, EVIOCGID, &id) == 0) {
+            identity.vendor  = id.vendor;
+            identity.product = id.product;
+        }
+    } else {
+        ok = false;
+    }
+    ::close(fd);
+    return ok;
+}
+
+bool hasDeviceIdentity(const JoystickConfig &config) {
+    return config.deviceName[0] != '\0' || config.vendorId != 0 || config.productId != 0;
+}
+
+bool matchesDeviceIdentity(const JoystickConfig &config, const InputDeviceIdentity &identity) {
+    if (config.deviceName[0] != '\0' && std::strncmp(config.deviceName, identity.name, CONFIG_PATH_MAX) != 0) {
+        return false;
+    }
+    if (config.vendorId != 0 && config.vendorId != identity.vendor) {
+        return false;
+    }
+    return config.productId == 0 || config.productId == identity.product;
+}
+
+bool findInputDevice(const JoystickConfig &config, std::string &path) {
+    InputBackendType type = resolveBackendType(config.backend, config.devicePath);
+    if (type == InputBackendType::Replay) {
+        return false;
+    }
+    const char *prefix = type == InputBackendType::Evdev ? "event" : "js";
+    size_t prefixLength = std::strlen(prefix);
+
+    const char *slash = std::strrchr(config.devicePath, '/');
+    std::string dir = slash ? std::string(config.devicePath, slash == config.devicePath ? 1 : slash - config.devicePath)
+                            : std::string(".");
+    DIR *handle = opendir(dir.c_str());
+    if (handle == nullptr) {
+        return false;
+    }
+    std::vector<std::string> nodes;
+    while (struct dirent *entry = readdir(handle)) {
+        if (std::strncmp(entry->d_name, prefix, prefixLength) == 0) {
+            nodes.push_back(entry->d_name);
+        }
+    }
+    closedir(handle);
+
+    // js2 < js10이 되도록 길이 먼저 비교
+    std::sort(nodes.begin(), nodes.end(), [](const std::string &a, const std::string &b) {
+        return a.size() != b.size() ? a.size() < b.size() : a < b;
+    });
+    for (const std::string &node : nodes) {
+        std::string candidate = (dir == "/" ? dir : dir + "/") + node;
+        InputDeviceIdentity identity;
+        if (readInputDeviceIdentity(candidate.c_str(), identity) && matchesDeviceIdentity(config, identity)) {
+            path = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isDeviceNodeCandidate(const JoystickConfig &config, const std::string &dir, const char *name) {
+    const char *slash = std::strrchr(config.devicePath, '/');
+    if (slash == nullptr) {
+        return false;
+    }
+    size_t dirLength = slash == config.devicePath ? 1 : static_cast<size_t>(slash - config.devicePath);
+    if (dir.size() != dirLength || dir.compare(0, dirLength, config.devicePath, dirLength) != 0) {
+        return false;
+    }
+    if (std::strcmp(name, slash + 1) == 0) {
+        return true;
+    }
+    if (!hasDeviceIdentity(config)) {
+        return false;
+    }
+    InputBackendType type = resolveBackendType(config.backend, config.devicePath);
+    if (type == InputBackendType::Replay) {
+        return false;
+    }
+    const char *prefix = type == InputBackendType::Evdev ? "event" : "js";
+    return std::strncmp(name, prefix, std::strlen(prefix)) == 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+
+std::unique_ptr<InputBackend> makeJoydevBackend(int fd) {
+    return std::unique_ptr<InputBackend>(new JoydevBackend(fd));
+}
+
+std::unique_ptr<InputBackend> makeInputBackend(InputBackendType type, const char *devicePath) {
+    type = resolveBackendType(type, devicePath);
+    if (type == InputBackendType::Replay) {
+        return std::unique_ptr<InputBackend>(new ReplayBackend());
+    }
+    if (type == InputBackendType::Evdev) {
+        return std::unique_ptr<InputBackend>(new EvdevBackend());
+    }
+    return std::unique_ptr<InputBackend>(new JoydevBackend());
+}
+
+}  // namespace joy
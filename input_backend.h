@@ -0,0 +1,134 @@
+#ifndef JOYSTICK_INPUT_BACKEND_H
+#define JOYSTICK_INPUT_BACKEND_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "joystick.h"
+
+namespace joy {
+
+class InputRecorder;
+
+// 한 번의 drain 호출 결과
+struct InputDrainResult {
+    uint32_t events;        // 반영한 입력 이벤트 수 (SYN 이벤트 제외)
+    bool     killPressed;   // Kill Switch 버튼 눌림 이벤트가 있었으면 true
+    int64_t  eventTimeNs;   // 마지막으로 반영한 이벤트(프레임)의 커널 타임스탬프 (CLOCK_MONOTONIC ns, 없으면 0)
+};
+
+/**
+ * @brief InputBackend
+ *
+ * 커널 입력 장치 하나를 열고 쌓인 이벤트를 JoystickState(raw)로 옮기는 인터페이스.
+ * 축 값은 백엔드와 상관없이 joydev와 같은 [-RAW_AXIS_MAX_NEG, RAW_AXIS_MAX_POS] 범위로,
+ * 축/버튼 번호도 joydev와 같은 순서로 맞춰서 넘깁니다.
+ * JoystickDevice의 작업 스레드에서만 사용합니다.
+ */
+class InputBackend {
+public:
+    virtual ~InputBackend() = default;
+
+    virtual const char *name() const = 0;
+    virtual bool open(const char *devicePath) = 0;   // 논블록킹으로 연다
+    virtual void close() = 0;
+    virtual int fd() const = 0;
+
+    /**
+     * @brief 커널 큐에 쌓인 이벤트를 EAGAIN이 날 때까지 모두 읽어 localState에 반영
+     *
+     * @param localState  이벤트를 반영할 raw 상태
+     * @param killButton  Kill Switch 버튼 인덱스
+     * @param edges       버튼 값이 바뀔 때마다 edge를 추가할 큐 (nullptr이면 기록 안 함).
+     *                    한 번의 drain 안에서 눌렀다 뗀 짧은 탭도 빠짐없이 기록됩니다.
+     * @param result      반영 결과 (출력)
+     * @return 디바이스가 끊어졌으면 false
+     */
+    virtual bool drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+                       InputDrainResult &result) = 0;
+
+    // 읽은 입력을 녹화할 대상 (nullptr이면 녹화 안 함). 녹화 중이 아니면 기록 비용은 atomic load 하나
+    void setRecorder(InputRecorder *recorder) { recorder_ = recorder; }
+
+protected:
+    InputRecorder *recorder_ = nullptr;
+};
+
+/**
+ * @brief HotplugWatcher
+ *
+ * inotify로 장치 노드가 있는 디렉터리(예: /dev/input)를 감시합니다. 노드가 새로 생기거나(IN_CREATE),
+ * 이름이 바뀌어 들어오거나(IN_MOVED_TO), udev가 권한을 바꾸면(IN_ATTRIB) fd가 readable이 되고
+ * readChanges가 알림마다 디렉터리와 노드 이름을 알려 주므로, 호출 측은 자기 장치일 수 있는 노드
+ * (isDeviceNodeCandidate)에서만 재연결 주기를 기다리지 않고 바로 다시 열어 볼 수 있습니다.
+ * 마우스·키보드 같은 다른 노드의 알림은 무시되어 장치를 훑지 않습니다.
+ * 노드가 막 생겼을 때는 아직 권한이 없어 open이 실패할 수 있는데, 뒤따르는 IN_ATTRIB에서 다시 시도됩니다.
+ * JoystickManager의 작업 스레드에서만 사용합니다.
+ */
+class HotplugWatcher {
+public:
+    HotplugWatcher();
+    ~HotplugWatcher();
+
+    HotplugWatcher(const HotplugWatcher &) = delete;
+    HotplugWatcher &operator=(const HotplugWatcher &) = delete;
+
+    // 장치 경로의 상위 디렉터리를 감시에 추가 (절대 경로만. 같은 디렉터리를 여러 번 넣어도 됨)
+    bool watchParentOf(const char *devicePath);
+    int fd() const;      // epoll에 등록할 non-blocking fd (inotify를 쓸 수 없으면 -1)
+
+    // 쌓인 알림을 모두 비우며 알림마다 onNode(감시 디렉터리, 노드 이름)를 부름. 하나라도 있었으면 true
+    // 알림 큐가 넘쳐(IN_Q_OVERFLOW) 어떤 노드인지 잃었으면 name = nullptr로 한 번 부름
+    using NodeCallback = std::function<void(const std::string &dir, const char *name)>;
+    bool readChanges(const NodeCallback &onNode);
+
+private:
+    int fd_;
+    std::vector<std::pair<int, std::string>> watches_;   // inotify watch descriptor → 디렉터리
+};
+
+// 입력 장치 노드의 식별 정보 (readInputDeviceIdentity)
+struct InputDeviceIdentity {
+    char     name[CONFIG_PATH_MAX];   // JSIOCGNAME / EVIOCGNAME
+    uint16_t vendor;                  // USB vendor ID (알 수 없으면 0)
+    uint16_t product;                 // USB product ID (알 수 없으면 0)
+};
+
+// 노드를 잠깐 열어 이름과 ID를 읽음 (joydev 노드의 ID는 sysfs에서 읽음). 입력 장치가 아니면 false
+bool readInputDeviceIdentity(const char *devicePath, InputDeviceIdentity &identity);
+
+// config에 장치 이름이나 ID가 지정돼 있는지
+bool hasDeviceIdentity(const JoystickConfig &config);
+
+// identity가 config에 지정된 이름/ID와 모두 맞는지 (지정하지 않은 항목은 비교하지 않음)
+bool matchesDeviceIdentity(const JoystickConfig &config, const InputDeviceIdentity &identity);
+
+/**
+ * @brief config.devicePath와 같은 디렉터리에서 식별 정보가 맞는 노드를 찾음
+ *
+ * 백엔드와 같은 종류의 노드(joydev면 js*, evdev면 event*)만 이름 순으로 열어 봅니다.
+ * 노드마다 open + ioctl 몇 번이므로 재연결 시도 때만 부릅니다.
+ *
+ * @return 찾았으면 true와 함께 path에 노드 경로
+ */
+bool findInputDevice(const JoystickConfig &config, std::string &path);
+
+// dir에 생긴 노드 name이 config의 장치일 수 있는지 (핫플러그 알림 거르기)
+//  - 식별 정보가 없으면 devicePath와 같은 디렉터리의 같은 이름만
+//  - 있으면 findInputDevice가 훑는 노드(같은 디렉터리의 js* 또는 event*)도
+bool isDeviceNodeCandidate(const JoystickConfig &config, const std::string &dir, const char *name);
+
+// 이미 열린 fd(파이프, 소켓 등)에서 js_event를 읽는 joydev 백엔드. fd 소유권을 가져가며
+// open()에 넘어오는 경로는 무시합니다. (fake_joystick.h의 가짜 장치가 사용)
+std::unique_ptr<InputBackend> makeJoydevBackend(int fd);
+
+// type에 맞는 백엔드 생성. Auto는 경로가 .joyrec로 끝나면 replay,
+// 경로 이름이 "event"로 시작하면 evdev, 아니면 joydev
+std::unique_ptr<InputBackend> makeInputBackend(InputBackendType type, const char *devicePath);
+
+}  // namespace joy
+#endif // JOYSTICK_INPUT_BACKEND_H
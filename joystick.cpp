@@ -1,11 +1,30 @@
 #include "joystick.h"
+#include "axis_pipeline.h"
+#include "input_backend.h"
+#include "recorder.h"
+#include "shared_state.h"
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <algorithm>
 #include <fcntl.h>
 #include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/timerfd.h>
+#include <linux/futex.h>
+#include <time.h>
 #include <cmath>   // for std::fabs
 #include <chrono>  // for time measurement
+#include <mutex>
+#include <type_traits>
 
 #define ANSI_COLOR_RED     "\033[1;31m"
 #define ANSI_COLOR_GREEN   "\033[1;32m"
@@ -17,38 +36,425 @@ namespace joy {
 // 초기값은 false (입력 무시)
 std::atomic<bool> inputEnabled{false};
 
-// 내부 스레드에서 관리되는 전역 상태 변수 (뮤텍스로 보호됨)
-static JoystickState head_shared = {0};
-std::mutex joystick_mutex;
+// 끊어진 장치의 재연결 시도 간격
+static constexpr int64_t RECONNECT_INTERVAL_NS = 1000000000LL;  // 1초
+static constexpr int64_t RECONNECT_LOG_INTERVAL_NS = 10000000000LL;  // 재연결 대기 로그 간격 10초
 
-// updateSharedState가 사용하는 LPF 필터 상태 (스텝 간 유지).
-// 재연결/Kill Switch 시 옛 방향값이 남아 출력이 튀는 것을 막기 위해
-// 파일 스코프로 두고 resetFilterState()로 초기화한다.
-static bool  g_firstCall = true;
-static float g_filteredRaw[joy::MAX_AXES] = {0.0f};
+// 다음에 시작되는 JoystickManager::run이 사용할 루프 방식
+static std::atomic<LoopMode> g_loopMode{CONFIG_DEFAULT_LOOP_MODE};
 
-JoystickState getJoystickState() {
-    std::lock_guard<std::mutex> lock(joystick_mutex);
-    return head_shared;
+// 모든 축을 CONFIG_RESPONSE_CURVE로 채운 기본 곡선 묶음
+static AxisCurves makeDefaultAxisCurves() {
+    AxisCurves curves;
+    for (int i = 0; i < MAX_AXES; ++i) {
+        curves.axes[i] = makeResponseCurve(CONFIG_RESPONSE_CURVE, CONFIG_CURVE_EXPO);
+    }
+    return curves;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JoystickConfig
+// ─────────────────────────────────────────────────────────────────────────────
+
+JoystickConfig defaultJoystickConfig(const char *devicePath) {
+    JoystickConfig config;
+    std::memset(&config, 0, sizeof(config));  // 패딩까지 0으로 (seqlock 비교/복사가 결정적이도록)
+    std::strncpy(config.devicePath, devicePath ? devicePath : CONFIG_JOYSTICK_DEVICE, CONFIG_PATH_MAX - 1);
+    std::strncpy(config.deviceName, CONFIG_DEVICE_NAME, CONFIG_PATH_MAX - 1);
+    config.vendorId           = CONFIG_DEVICE_VENDOR_ID;
+    config.productId          = CONFIG_DEVICE_PRODUCT_ID;
+    config.backend            = InputBackendType::Auto;
+    config.loopHz             = CONFIG_JOYSTICK_HZ;
+    config.initDelaySec       = CONFIG_INIT_DELAY_SEC;
+    config.buttonStart        = CONFIG_BUTTON_START;
+    config.buttonKill         = CONFIG_BUTTON_KILL;
+    config.filterTau          = CONFIG_FILTER_TAU;
+    config.filterType         = CONFIG_FILTER_TYPE;
+    config.filterCutoffHz     = CONFIG_FILTER_CUTOFF_HZ;
+    config.oneEuroBeta        = CONFIG_ONE_EURO_BETA;
+    config.oneEuroDCutoffHz   = CONFIG_ONE_EURO_D_CUTOFF_HZ;
+    config.deadZone           = CONFIG_DEFAULT_DEADZONE;
+    config.accumRate          = CONFIG_ACCUM_RATE;
+#ifdef CONFIG_USE_SLEW
+    config.useSlew            = true;
+#else
+    config.useSlew            = false;
+#endif
+    config.slewInitialMaxRate = CONFIG_SLEW_INITIAL_MAX_RATE;
+    config.slewRunningMaxRate = CONFIG_SLEW_RUNNING_MAX_RATE;
+    config.slewSwitchTimeS    = CONFIG_SLEW_SWITCH_TIME_S;
+    config.buttonL1           = CONFIG_BUTTON_L1;
+    config.buttonR1           = CONFIG_BUTTON_R1;
+    config.buttonL2           = CONFIG_BUTTON_L2;
+    config.buttonR2           = CONFIG_BUTTON_R2;
+    config.curves             = makeDefaultAxisCurves();
+    std::strncpy(config.sharedMemoryName, CONFIG_SHARED_MEMORY_NAME, CONFIG_PATH_MAX - 1);
+    return config;
+}
+
+static bool configError(std::string *error, const std::string &message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+bool validateJoystickConfig(const JoystickConfig &config, std::string *error) {
+    size_t pathLen = strnlen(config.devicePath, CONFIG_PATH_MAX);
+    if (pathLen == 0 || pathLen >= static_cast<size_t>(CONFIG_PATH_MAX)) {
+        return configError(error, "device path must be 1.." + std::to_string(CONFIG_PATH_MAX - 1) + " characters");
+    }
+    if (strnlen(config.deviceName, CONFIG_PATH_MAX) >= static_cast<size_t>(CONFIG_PATH_MAX)) {
+        return configError(error, "device name must be shorter than " + std::to_string(CONFIG_PATH_MAX) + " characters");
+    }
+    size_t shmLen = strnlen(config.sharedMemoryName, CONFIG_PATH_MAX);
+    if (shmLen >= static_cast<size_t>(CONFIG_PATH_MAX) ||
+        (shmLen > 0 && (shmLen < 2 || config.sharedMemoryName[0] != '/' ||
+                        std::strchr(config.sharedMemoryName + 1, '/') != nullptr))) {
+        return configError(error, "shared_memory must be empty or \"/name\" without other '/'");
+    }
+    if (config.vendorId < 0 || config.vendorId > 0xffff || config.productId < 0 || config.productId > 0xffff) {
+        return configError(error, "vendor_id / product_id must be in 0..ffff");
+    }
+    if (static_cast<int>(config.backend) < static_cast<int>(InputBackendType::Auto) ||
+        static_cast<int>(config.backend) > static_cast<int>(InputBackendType::Replay)) {
+        return configError(error, "invalid backend");
+    }
+    if (config.loopHz < 1 || config.loopHz > 10000) {
+        return configError(error, "hz must be in 1..10000");
+    }
+    if (!(config.initDelaySec >= 0.0f)) {
+        return configError(error, "init_delay_sec must be >= 0");
+    }
+    if (!(config.filterTau >= 0.0f)) {
+        return configError(error, "filter_tau must be >= 0");
+    }
+    if (static_cast<int>(config.filterType) < static_cast<int>(FilterType::Ema) ||
+        static_cast<int>(config.filterType) > static_cast<int>(FilterType::OneEuro)) {
+        return configError(error, "invalid filter");
+    }
+    if (!(config.filterCutoffHz > 0.0f)) {
+        return configError(error, "filter_cutoff_hz must be > 0");
+    }
+    if (!(config.oneEuroBeta >= 0.0f)) {
+        return configError(error, "one_euro_beta must be >= 0");
+    }
+    if (!(config.oneEuroDCutoffHz > 0.0f)) {
+        return configError(error, "one_euro_d_cutoff_hz must be > 0");
+    }
+    if (!(config.deadZone >= 0.0f && config.deadZone < 1.0f)) {
+        return configError(error, "deadzone must be in [0, 1)");
+    }
+    if (!(config.accumRate >= 0.0f) || !(config.slewInitialMaxRate >= 0.0f) ||
+        !(config.slewRunningMaxRate >= 0.0f) || !(config.slewSwitchTimeS >= 0.0f)) {
+        return configError(error, "rates and times must be >= 0");
+    }
+    const int buttons[] = {config.buttonStart, config.buttonKill, config.buttonL1,
+                           config.buttonR1, config.buttonL2, config.buttonR2};
+    for (int button : buttons) {
+        if (button < 0 || button >= MAX_BUTTONS) {
+            return configError(error, "button index must be in 0.." + std::to_string(MAX_BUTTONS - 1));
+        }
+    }
+    for (int i = 0; i < MAX_AXES; ++i) {
+        const ResponseCurve &curve = config.curves.axes[i];
+        if (static_cast<int>(curve.type) < static_cast<int>(CurveType::Linear) ||
+            static_cast<int>(curve.type) > static_cast<int>(CurveType::Lut)) {
+            return configError(error, "axis" + std::to_string(i) + ": invalid curve type");
+        }
+        if (!(curve.expo >= 0.0f && curve.expo <= 1.0f)) {
+            return configError(error, "axis" + std::to_string(i) + ": expo must be in [0, 1]");
+        }
+    }
+    return true;
+}
+
+// 앞뒤 공백 제거
+static std::string trimConfigToken(const std::string &text) {
+    size_t begin = text.find_first_not_of(" \t\r");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+static bool parseConfigFloat(const std::string &text, float &value) {
+    char *end = nullptr;
+    errno = 0;
+    float parsed = std::strtof(text.c_str(), &end);
+    if (text.empty() || errno != 0 || *end != '\0') {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+static bool parseConfigInt(const std::string &text, int &value) {
+    char *end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || errno != 0 || *end != '\0' || parsed < -100000 || parsed > 100000) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// USB ID ("054c" 또는 "0x054c")
+static bool parseConfigHex(const std::string &text, int &value) {
+    char *end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(text.c_str(), &end, 16);
+    if (text.empty() || errno != 0 || *end != '\0' || parsed < 0 || parsed > 0xffff) {
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+static bool parseConfigBool(const std::string &text, bool &value) {
+    if (text == "1" || text == "true" || text == "on" || text == "yes") {
+        value = true;
+        return true;
+    }
+    if (text == "0" || text == "false" || text == "off" || text == "no") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+static bool parseConfigBackend(const std::string &text, InputBackendType &type) {
+    static const struct { const char *name; InputBackendType type; } names[] = {
+        {"auto", InputBackendType::Auto}, {"joydev", InputBackendType::Joydev}, {"evdev", InputBackendType::Evdev},
+        {"replay", InputBackendType::Replay},
+    };
+    for (const auto &entry : names) {
+        if (text == entry.name) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseConfigFilterType(const std::string &text, FilterType &type) {
+    static const struct { const char *name; FilterType type; } names[] = {
+        {"ema", FilterType::Ema}, {"butterworth", FilterType::Butterworth},
+        {"critically_damped", FilterType::CriticallyDamped}, {"one_euro", FilterType::OneEuro},
+    };
+    for (const auto &entry : names) {
+        if (text == entry.name) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseConfigCurveType(const std::string &text, CurveType &type) {
+    static const struct { const char *name; CurveType type; } names[] = {
+        {"linear", CurveType::Linear}, {"quadratic", CurveType::Quadratic}, {"cubic", CurveType::Cubic},
+        {"expo", CurveType::Expo},     {"lut", CurveType::Lut},
+    };
+    for (const auto &entry : names) {
+        if (text == entry.name) {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// "y0, y1, ..., y8" 형태의 Lut 값
+static bool parseConfigLut(const std::string &text, float (&lut)[CURVE_LUT_POINTS]) {
+    std::stringstream stream(text);
+    std::string item;
+    int count = 0;
+    float values[CURVE_LUT_POINTS];
+    while (std::getline(stream, item, ',')) {
+        if (count >= CURVE_LUT_POINTS || !parseConfigFloat(trimConfigToken(item), values[count])) {
+            return false;
+        }
+        ++count;
+    }
+    if (count != CURVE_LUT_POINTS) {
+        return false;
+    }
+    std::copy(values, values + CURVE_LUT_POINTS, lut);
+    return true;
+}
+
+// key = value 한 쌍을 config에 반영. 모르는 키나 잘못된 값이면 false
+static bool applyConfigEntry(JoystickConfig &config, const std::string &key, const std::string &value) {
+    struct FloatKey { const char *name; float JoystickConfig::*field; };
+    struct IntKey   { const char *name; int JoystickConfig::*field; };
+    static const FloatKey floatKeys[] = {
+        {"init_delay_sec", &JoystickConfig::initDelaySec},
+        {"filter_tau", &JoystickConfig::filterTau},
+        {"filter_cutoff_hz", &JoystickConfig::filterCutoffHz},
+        {"one_euro_beta", &JoystickConfig::oneEuroBeta},
+        {"one_euro_d_cutoff_hz", &JoystickConfig::oneEuroDCutoffHz},
+        {"deadzone", &JoystickConfig::deadZone},
+        {"accum_rate", &JoystickConfig::accumRate},
+        {"slew_initial_max_rate", &JoystickConfig::slewInitialMaxRate},
+        {"slew_running_max_rate", &JoystickConfig::slewRunningMaxRate},
+        {"slew_switch_time_s", &JoystickConfig::slewSwitchTimeS},
+    };
+    static const IntKey intKeys[] = {
+        {"hz", &JoystickConfig::loopHz},
+        {"button_start", &JoystickConfig::buttonStart},
+        {"button_kill", &JoystickConfig::buttonKill},
+        {"button_l1", &JoystickConfig::buttonL1},
+        {"button_r1", &JoystickConfig::buttonR1},
+        {"button_l2", &JoystickConfig::buttonL2},
+        {"button_r2", &JoystickConfig::buttonR2},
+    };
+
+    if (key == "device") {
+        if (value.empty() || value.size() >= static_cast<size_t>(CONFIG_PATH_MAX)) {
+            return false;
+        }
+        std::memset(config.devicePath, 0, sizeof(config.devicePath));
+        std::memcpy(config.devicePath, value.data(), value.size());
+        return true;
+    }
+    if (key == "device_name") {
+        if (value.size() >= static_cast<size_t>(CONFIG_PATH_MAX)) {
+            return false;
+        }
+        std::memset(config.deviceName, 0, sizeof(config.deviceName));
+        std::memcpy(config.deviceName, value.data(), value.size());
+        return true;
+    }
+    if (key == "shared_memory") {
+        if (value.size() >= static_cast<size_t>(CONFIG_PATH_MAX)) {
+            return false;
+        }
+        std::memset(config.sharedMemoryName, 0, sizeof(config.sharedMemoryName));
+        std::memcpy(config.sharedMemoryName, value.data(), value.size());
+        return true;
+    }
+    if (key == "vendor_id") {
+        return parseConfigHex(value, config.vendorId);
+    }
+    if (key == "product_id") {
+        return parseConfigHex(value, config.productId);
+    }
+    if (key == "backend") {
+        return parseConfigBackend(value, config.backend);
+    }
+    if (key == "filter") {
+        return parseConfigFilterType(value, config.filterType);
+    }
+    if (key == "use_slew") {
+        return parseConfigBool(value, config.useSlew);
+    }
+    for (const auto &entry : floatKeys) {
+        if (key == entry.name) {
+            return parseConfigFloat(value, config.*entry.field);
+        }
+    }
+    for (const auto &entry : intKeys) {
+        if (key == entry.name) {
+            return parseConfigInt(value, config.*entry.field);
+        }
+    }
+
+    // curve / curve_expo: 모든 축, axisN.curve / axisN.expo / axisN.lut: 축 N
+    int first = 0, last = MAX_AXES - 1;
+    std::string field = key;
+    if (key.compare(0, 4, "axis") == 0) {
+        size_t dot = key.find('.');
+        int axis = -1;
+        if (dot == std::string::npos || !parseConfigInt(key.substr(4, dot - 4), axis) ||
+            axis < 0 || axis >= MAX_AXES) {
+            return false;
+        }
+        first = last = axis;
+        field = key.substr(dot + 1);
+    } else if (key == "curve_expo") {
+        field = "expo";
+    }
+
+    for (int i = first; i <= last; ++i) {
+        ResponseCurve &curve = config.curves.axes[i];
+        bool ok = false;
+        if (field == "curve") {
+            ok = parseConfigCurveType(value, curve.type);
+        } else if (field == "expo") {
+            ok = parseConfigFloat(value, curve.expo);
+        } else if (field == "lut" && first == last) {
+            ok = parseConfigLut(value, curve.lut);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseJoystickConfigFile(const char *path, JoystickConfig &config, std::string *error) {
+    std::ifstream file(path);
+    if (!file) {
+        return configError(error, std::string("cannot open ") + path + ": " + std::strerror(errno));
+    }
+
+    JoystickConfig parsed = config;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        line = trimConfigToken(line);
+        if (line.empty()) {
+            continue;
+        }
+        size_t eq = line.find('=');
+        std::string key = eq == std::string::npos ? line : trimConfigToken(line.substr(0, eq));
+        if (eq == std::string::npos ||
+            !applyConfigEntry(parsed, key, trimConfigToken(line.substr(eq + 1)))) {
+            return configError(error, std::string(path) + ":" + std::to_string(lineNumber) +
+                                      ": invalid entry '" + key + "'");
+        }
+    }
+
+    std::string reason;
+    if (!validateJoystickConfig(parsed, &reason)) {
+        return configError(error, std::string(path) + ": " + reason);
+    }
+    config = parsed;
+    return true;
 }
 
 /**
  * @brief resetFilterState
  *
- * updateSharedState 내부의 LPF 필터 상태(g_filteredRaw)와 g_firstCall을 초기화한다.
+ * updateSharedState가 쓰는 LPF 필터 상태(filteredRaw)와 firstCall을 초기화한다.
  * 연결이 끊겼다 다시 붙을 때 직전 주행/회전 방향의 filteredRaw 잔상이 남아
  * 입력이 그 방향으로 순간 튀는 현상을 막는다.
  *
- * g_firstCall = true 로 되돌리면 다음 updateSharedState 호출에서
+ * firstCall = true 로 되돌리면 다음 updateSharedState 호출에서
  * 현재 raw 값(보통 중립)으로 필터를 다시 채운다.
+ * 슬루율 경과 시간(slewElapsedS)은 장치가 처음 입력을 받은 뒤로 계속 누적되며 여기서 초기화하지 않는다.
  *
- * 주의: joystick_mutex를 잡은 상태에서 호출할 것.
+ * 주의: 해당 장치의 작업 스레드에서만 호출할 것.
  */
-void resetFilterState() {
-    g_firstCall = true;
+void resetFilterState(AxisFilterState &filter) {
+    filter.firstCall = true;
     for (int i = 0; i < joy::MAX_AXES; ++i) {
-        g_filteredRaw[i] = 0.0f;
+        filter.filteredRaw[i] = 0.0f;
+        filter.biquad.z1[i] = 0.0;
+        filter.biquad.z2[i] = 0.0;
+        filter.oneEuro.value[i] = 0.0;
+        filter.oneEuro.prevRaw[i] = 0.0;
+        filter.oneEuro.speed[i] = 0.0;
     }
+    filter.biquad.valid = false;   // 다음 호출에서 계수를 다시 계산
 }
 
 // Low-pass filter function (exponential moving average)
@@ -59,28 +465,22 @@ float lowpassFilter_Joy(float previous, float current, float alpha) {
 /**
  * @brief scaleJoystickOutput
  *
- * 1) Dead zone 처리:
+ * 1) Dead zone 처리 (applyDeadzone):
  *    절대값(absVal)이 deadZoneThreshold 이하면 0으로 간주해
- *    손떨림이나 미세한 노이즈로 인한 불필요한 입력을 무시합니다.
+ *    손떨림이나 미세한 노이즈로 인한 불필요한 입력을 무시하고,
+ *    [deadZoneThreshold, 1] 구간을 [0,1]로 선형 매핑합니다.
  *
- * 2) Ramp-up 스케일링:
- *    [deadZoneThreshold, 1] 구간을 [0,1]로 선형 매핑한 뒤
- *    제곱(curve = x^2)을 적용해 저속 영역에서 더 부드러운 출력을 만듭니다.
+ * 2) 응답 곡선 (evalCurve):
+ *    축별로 설정된 곡선(Linear/Quadratic/Cubic/Expo/Lut)을 적용합니다.
+ *    기본값은 CONFIG_RESPONSE_CURVE (x^2)로, 저속 영역에서 더 부드러운 출력을 만듭니다.
  *
  * @param normalized        -1.0 ~ 1.0으로 정규화된 입력 값
  * @param deadZoneThreshold 데드존 임계치 (0.0 ~ 1.0)
+ * @param curve             이 축의 응답 곡선
  * @return 스케일링 후 출력 값 (-1.0 ~ 1.0)
  */
-float scaleJoystickOutput(float normalized, float deadZoneThreshold) {
-    float absVal = std::fabs(normalized);
-    if (absVal < deadZoneThreshold) {
-        return 0.0f;
-    }
-    // Compute adjusted value: linearly map [deadZoneThreshold, 1] to [0, 1]
-    float adjusted = (absVal - deadZoneThreshold) / (1.0f - deadZoneThreshold);
-    // Apply a quadratic scaling for a smoother, gradual ramp-up.
-    adjusted = std::pow(adjusted, 2.0f); 
-    return (normalized >= 0) ? adjusted : -adjusted;
+float scaleJoystickOutput(float normalized, float deadZoneThreshold, const ResponseCurve &curve) {
+    return shapeAxis(normalized, deadZoneThreshold, curve);
 }
 
 // Applies a slew rate limiter to smooth the output changes.
@@ -116,9 +516,245 @@ float normalizeAxisValue(float raw) {
     }
 }
 
+AxisPipelineParams makeAxisPipelineParams(float alpha, float deadZoneThreshold, float maxDelta,
+                                          bool useSlew, const AxisCurves &curves) {
+    AxisPipelineParams params;
+    params.alpha = alpha;
+    params.deadZoneThreshold = deadZoneThreshold;
+    params.maxDelta = maxDelta;
+    params.useSlew = useSlew;
+    params.applyLowpass = true;
+    params.curves = curves;
+    params.lutMask = 0;
+
+    // 다항식 곡선은 y = x * (c1 + x * (c2 + x * c3)) 한 가지 형태로 통일한다.
+    // 계수를 0/1로 두면 evalCurve<C>와 같은 순서의 곱셈만 남아 결과가 비트 단위로 같다.
+    for (int i = 0; i < MAX_AXES; ++i) {
+        const ResponseCurve &curve = curves.axes[i];
+        float c1 = 0.0f, c2 = 0.0f, c3 = 0.0f;
+        switch (curve.type) {
+            case CurveType::Linear:    c1 = 1.0f; break;
+            case CurveType::Quadratic: c2 = 1.0f; break;
+            case CurveType::Cubic:     c3 = 1.0f; break;
+            case CurveType::Expo:      c1 = 1.0f - curve.expo; c3 = curve.expo; break;
+            case CurveType::Lut:       c1 = 1.0f; params.lutMask |= 1u << i; break;
+        }
+        params.curveC1[i] = c1;
+        params.curveC2[i] = c2;
+        params.curveC3[i] = c3;
+    }
+    return params;
+}
+
+/**
+ * @brief processAxesScalar
+ *
+ * 축 파이프라인의 스칼라 기준 구현. 단계 함수(lowpassFilter_Joy, normalizeAxisValue,
+ * scaleJoystickOutput, applySlewRate)를 축마다 차례로 호출합니다.
+ * processAxesBatch 결과 검증 및 벤치마크 비교용입니다.
+ *
+ * @param raw       축 raw 값
+ * @param filtered  LPF 상태 (입력: 직전 값, 출력: 갱신된 값). applyLowpass가 false면 이미 걸러진 입력
+ * @param out       축 출력 (입력: 직전 출력(슬루 기준), 출력: 새 출력)
+ * @param params    파이프라인 파라미터
+ */
+void processAxesScalar(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                       const AxisPipelineParams &params) {
+    for (int i = 0; i < MAX_AXES; ++i) {
+        if (params.applyLowpass) {
+            filtered[i] = lowpassFilter_Joy(filtered[i], raw[i], params.alpha);
+        }
+        float normalized = normalizeAxisValue(filtered[i]);
+        float scaled = scaleJoystickOutput(normalized, params.deadZoneThreshold, params.curves.axes[i]);
+        out[i] = params.useSlew ? applySlewRate(out[i], scaled, params.maxDelta) : scaled;
+    }
+}
+
+#if defined(__GNUC__)
+// 타깃의 기본 벡터 폭으로 축을 묶어 처리한다.
+// AVX에서는 8축이 레지스터 하나, SSE/NEON에서는 4축씩 두 번에 처리된다.
+// (8폭 벡터를 SSE에서 에뮬레이션하면 비교 연산이 스칼라로 풀려 오히려 느려진다.)
+#if defined(__AVX__)
+constexpr int AXIS_LANES = 8;
+#else
+constexpr int AXIS_LANES = 4;
+#endif
+static_assert(MAX_AXES % AXIS_LANES == 0, "MAX_AXES must be a multiple of AXIS_LANES");
+
+typedef float   AxisVec  __attribute__((vector_size(AXIS_LANES * sizeof(float))));
+typedef int32_t AxisMask __attribute__((vector_size(AXIS_LANES * sizeof(int32_t))));
+
+// 벡터를 값으로 주고받으면 AVX 미사용 빌드에서 ABI 경고가 나므로 참조로 전달한다.
+static inline void loadAxisVec(AxisVec &v, const float *src) {
+    std::memcpy(&v, src, sizeof(v));
+}
+
+static inline void storeAxisVec(float *dst, const AxisVec &v) {
+    std::memcpy(dst, &v, sizeof(v));
+}
+
+static inline void broadcastAxisVec(AxisVec &v, float value) {
+    for (int i = 0; i < AXIS_LANES; ++i) {
+        v[i] = value;
+    }
+}
+
+template <bool UseSlew, bool UseLowpass>
+static void processAxesVector(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                              const AxisPipelineParams &params) {
+    // 스칼라 파라미터는 미리 벡터로 펼쳐 둔다 (벡터-스칼라 혼합 연산은 스칼라로 풀릴 수 있음)
+    AxisVec zero, alpha, dz, dzRange, maxNeg, maxPos, maxDelta;
+    broadcastAxisVec(zero, 0.0f);
+    broadcastAxisVec(alpha, params.alpha);
+    broadcastAxisVec(dz, params.deadZoneThreshold);
+    broadcastAxisVec(dzRange, 1.0f - params.deadZoneThreshold);
+    broadcastAxisVec(maxNeg, RAW_AXIS_MAX_NEG);
+    broadcastAxisVec(maxPos, RAW_AXIS_MAX_POS);
+    broadcastAxisVec(maxDelta, params.maxDelta);
+    AxisMask absMask;
+    for (int i = 0; i < AXIS_LANES; ++i) {
+        absMask[i] = 0x7fffffff;
+    }
+
+    for (int base = 0; base < MAX_AXES; base += AXIS_LANES) {
+        AxisVec f, c1, c2, c3;
+        loadAxisVec(f, filtered + base);
+        loadAxisVec(c1, params.curveC1 + base);
+        loadAxisVec(c2, params.curveC2 + base);
+        loadAxisVec(c3, params.curveC3 + base);
+
+        // 1) LPF (EMA). 2차 필터 모드에서는 호출 측이 이미 filtered에 걸러 둠
+        if (UseLowpass) {
+            AxisVec rawVec;
+            loadAxisVec(rawVec, raw + base);
+            f = f + alpha * (rawVec - f);
+            storeAxisVec(filtered + base, f);
+        }
+
+        // 2) 정규화: 부호에 따라 나눌 값 선택
+        AxisVec normalized = f / (f < zero ? maxNeg : maxPos);
+
+        // 3) 데드존 + 곡선 (크기에 대해 계산 후 부호 복원)
+        AxisVec absVal = (AxisVec)((AxisMask)normalized & absMask);
+        AxisVec x = (absVal - dz) / dzRange;
+        x = absVal < dz ? zero : x;
+        AxisVec magnitude = x * (c1 + x * (c2 + x * c3));
+        if ((params.lutMask >> base) & ((1u << AXIS_LANES) - 1)) {
+            float xs[AXIS_LANES], ms[AXIS_LANES];
+            storeAxisVec(xs, x);
+            storeAxisVec(ms, magnitude);
+            for (int i = 0; i < AXIS_LANES; ++i) {
+                if (params.lutMask & (1u << (base + i))) {
+                    ms[i] = evalCurveLut(params.curves.axes[base + i].lut, xs[i]);
+                }
+            }
+            loadAxisVec(magnitude, ms);
+        }
+        AxisVec scaled = normalized >= zero ? magnitude : -magnitude;
+
+        // 4) 슬루율 제한
+        if (UseSlew) {
+            AxisVec previous;
+            loadAxisVec(previous, out + base);
+            AxisVec diff = scaled - previous;
+            diff = diff > maxDelta ? maxDelta : diff;
+            diff = diff < -maxDelta ? -maxDelta : diff;
+            scaled = previous + diff;
+        }
+        storeAxisVec(out + base, scaled);
+    }
+}
+#endif
+
+/**
+ * @brief processAxesBatch
+ *
+ * processAxesScalar와 같은 계산을 8축 벡터 연산으로 분기 없이 수행합니다.
+ * 곡선은 다항식 계수로 통일해 처리하고, Lut 곡선 축만 스칼라로 보정합니다.
+ * GCC/Clang 벡터 확장을 쓸 수 없는 컴파일러에서는 processAxesScalar로 대체됩니다.
+ */
+void processAxesBatch(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                      const AxisPipelineParams &params) {
+#if defined(__GNUC__)
+    if (params.applyLowpass) {
+        if (params.useSlew) {
+            processAxesVector<true, true>(raw, filtered, out, params);
+        } else {
+            processAxesVector<false, true>(raw, filtered, out, params);
+        }
+    } else {
+        if (params.useSlew) {
+            processAxesVector<true, false>(raw, filtered, out, params);
+        } else {
+            processAxesVector<false, false>(raw, filtered, out, params);
+        }
+    }
+#else
+    processAxesScalar(raw, filtered, out, params);
+#endif
+}
+
+// 고정 파이프라인 상수 (사용자 설정 영역의 CONFIG_* 값)
+namespace {
+struct ConfiguredConstants {
+    static constexpr float dt                 = fixedTickDt<CONFIG_JOYSTICK_HZ>();
+    static constexpr float filterTau          = CONFIG_FILTER_TAU;
+    static constexpr float deadZone           = CONFIG_DEFAULT_DEADZONE;
+    static constexpr float curveExpo          = CONFIG_CURVE_EXPO;
+    static constexpr float slewInitialMaxRate = CONFIG_SLEW_INITIAL_MAX_RATE;
+    static constexpr float slewRunningMaxRate = CONFIG_SLEW_RUNNING_MAX_RATE;
+    static constexpr float rawMaxNeg          = RAW_AXIS_MAX_NEG;
+    static constexpr float rawMaxPos          = RAW_AXIS_MAX_POS;
+};
+
+#ifdef CONFIG_USE_SLEW
+constexpr bool FIXED_USE_SLEW = true;
+#else
+constexpr bool FIXED_USE_SLEW = false;
+#endif
+// Lut 곡선은 고정할 수 없으므로 matchesFixedPipeline이 항상 false (커널은 컴파일만 되도록 Linear로 둠)
+constexpr bool FIXED_CURVE_SUPPORTED = CONFIG_RESPONSE_CURVE != CurveType::Lut;
+constexpr CurveType FIXED_CURVE = FIXED_CURVE_SUPPORTED ? CONFIG_RESPONSE_CURVE : CurveType::Linear;
+
+using ConfiguredPipeline = Pipeline<
+    std::conditional_t<CONFIG_FILTER_TYPE == FilterType::Ema, EmaLowpass<ConfiguredConstants>, NoLowpass>,
+    std::conditional_t<ConfiguredConstants::deadZone == 0.0f, NoDeadzone, FixedDeadzone<ConfiguredConstants>>,
+    FixedCurve<FIXED_CURVE, ConfiguredConstants>,
+    std::conditional_t<FIXED_USE_SLEW, FixedSlew<ConfiguredConstants>, NoSlew>,
+    ConfiguredConstants>;
+}  // namespace
+
+const float FIXED_PIPELINE_DT = ConfiguredConstants::dt;
+
+void processAxesFixed(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                      bool initialSlewPhase) {
+    ConfiguredPipeline::process<MAX_AXES>(raw, filtered, out, initialSlewPhase);
+}
+
+bool matchesFixedPipeline(const JoystickConfig &config) {
+    if (!FIXED_CURVE_SUPPORTED || config.loopHz != CONFIG_JOYSTICK_HZ || config.filterType != CONFIG_FILTER_TYPE ||
+        config.deadZone != CONFIG_DEFAULT_DEADZONE || config.useSlew != FIXED_USE_SLEW) {
+        return false;
+    }
+    if (config.filterType == FilterType::Ema && config.filterTau != CONFIG_FILTER_TAU) {
+        return false;
+    }
+    if (config.useSlew && (config.slewInitialMaxRate != CONFIG_SLEW_INITIAL_MAX_RATE ||
+                           config.slewRunningMaxRate != CONFIG_SLEW_RUNNING_MAX_RATE)) {
+        return false;
+    }
+    for (int i = 0; i < MAX_AXES; ++i) {
+        const ResponseCurve &curve = config.curves.axes[i];
+        if (curve.type != FIXED_CURVE || (curve.type == CurveType::Expo && curve.expo != CONFIG_CURVE_EXPO)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /*
    updateSharedState:
-   Updates head_shared by low-pass filtering raw axis values,
+   Updates head by low-pass filtering raw axis values,
    normalizing them, and then applying scaling (dead zone + gradual ramp-up).
    Also applies a slew rate limiter (maxDelta is 0.1 for the first 1 second, then 0.001).
 */
@@ -127,74 +763,109 @@ float normalizeAxisValue(float raw) {
  * @brief updateSharedState
  *
  * localState.axes[]에 들어온 raw 축 값을 아래 순서로 처리하여
- * 내부 상태(head_shared)에 저장하고, 버튼 상태는 그대로 복사합니다.
+ * 장치의 작업용 출력 상태(head)에 저장하고, 버튼 상태는 그대로 복사합니다.
  *
- *  1) lowpassFilter_Joy로 노이즈 제거
+ *  1) 노이즈 제거: config.filterType에 따라 lowpassFilter_Joy(EMA) 또는 2차 필터 뱅크(BiquadBank)
  *  2) normalizeAxisValue로 –1~1 정규화
- *  3) scaleJoystickOutput으로 dead zone + 부드러운 ramp-up
+ *  3) scaleJoystickOutput으로 dead zone + 축별 응답 곡선
  *  4) applySlewRate로 슬루율 리미팅
  *
+ * 1)~4)는 processAxesBatch로 전체 축을 분기 없이 한 번에 처리합니다. 2차 필터와 OneEuro는
+ * processAxesBatch 앞에서 filteredRaw에 따로 걸러 두고 커널의 EMA 단계를 끕니다 (applyLowpass = false).
+ * 2차 필터 계수는 dt나 필터 설정이 바뀐 틱에만 다시 계산합니다.
+ * 커널 파라미터(곡선 계수 등)는 filter.params에 두고 filter.paramsValid가 false일 때(처음, 설정 변경 후)만
+ * 다시 만듭니다. 호출 측이 같은 filter에 다른 설정을 넘기려면 paramsValid를 false로 되돌려야 합니다.
+ * CONFIG_FIXED_RATE_PIPELINE 빌드에서는 설정이 빌드 상수와 같고 주기를 놓치지 않은 틱이면
+ * 1)~4)를 상수로 접힌 processAxesFixed로 처리합니다 (파라미터를 만들지 않음, 결과는 같음).
+ * (결과는 단계 함수를 축마다 호출하는 processAxesScalar와 비트 단위로 같습니다.)
+ *
+ * @param head              출력 상태 (axes, buttons 갱신)
+ * @param filter            장치별 필터 상태 (틱 간 유지)
  * @param localState        생(raw) 입력이 담긴 구조체
- * @param alpha             필터 계수
- * @param deadZoneThreshold dead zone 임계치
+ * @param dt                직전 틱 이후 경과 시간(초)
+ * @param config            필터 시정수, 데드존, 슬루율, 축별 응답 곡선
  */
-void updateSharedState(const JoystickState &localState, float dt, float deadZoneThreshold) {
-    
-    // Time constant to alpha conversion for EMA filter
-    float alpha = dt / (CONFIG_FILTER_TAU + dt);
-
-    // Use static variable to record the initial time.
-    static auto initTime = std::chrono::steady_clock::now();
-    auto now = std::chrono::steady_clock::now();
-    float elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - initTime).count() / 1000.0f;
-    
-    // Set maxDelta based on max rate per second * dt
-    float maxRate = (elapsed < CONFIG_SLEW_SWITCH_TIME_S) ? CONFIG_SLEW_INITIAL_MAX_RATE : CONFIG_SLEW_RUNNING_MAX_RATE;
-    float maxDelta = maxRate * dt;
+void updateSharedState(JoystickState &head, AxisFilterState &filter, const JoystickState &localState,
+                       float dt, const JoystickConfig &config) {
+    const float deadZoneThreshold = config.deadZone;
+    const AxisCurves &curves = config.curves;
+
+    // 슬루율 구간은 벽시계가 아니라 누적 dt로 판단한다 (같은 입력이면 실행 속도와 무관하게 같은 결과)
+    float elapsed = filter.slewElapsedS;
+    filter.slewElapsedS += dt;
 
     // 첫 호출(또는 재연결 후 resetFilterState 호출 직후)일 때는
     // filteredRaw를 raw 값으로 채워서 0→–1 과도 현상 및
     // 직전 방향값 잔상으로 인한 출력 스파이크를 방지합니다. (특히 L2 R2)
-    // 필터 상태(g_firstCall, g_filteredRaw)는 파일 스코프에 두어
+    // 필터 상태(filter.firstCall, filter.filteredRaw)는 장치마다 따로 두어
     // resetFilterState()로 외부에서 초기화할 수 있게 했습니다.
-    if (g_firstCall) {
+    if (filter.firstCall) {
             for (int i = 0; i < MAX_AXES; ++i) {
-                // raw 값 그대로 초기 세팅
-                g_filteredRaw[i] = localState.axes[i];
-                // 즉시 head_shared에 반영 (데드존+스케일링만)
-                float norm   = normalizeAxisValue(g_filteredRaw[i]);
-                float scaled = scaleJoystickOutput(norm, deadZoneThreshold);
-                head_shared.axes[i] = scaled;
+                // raw 값 그대로 초기 세팅 (2차 필터는 아래에서 이 값의 정상 상태로 채움)
+                filter.filteredRaw[i] = localState.axes[i];
+                // 즉시 head에 반영 (데드존+스케일링만)
+                float norm   = normalizeAxisValue(filter.filteredRaw[i]);
+                float scaled = scaleJoystickOutput(norm, deadZoneThreshold, curves.axes[i]);
+                head.axes[i] = scaled;
             }
             // 버튼도 바로 복사
             for (int i = 0; i < MAX_BUTTONS; ++i) {
-                head_shared.buttons[i] = localState.buttons[i];
+                head.buttons[i] = localState.buttons[i];
             }
-            g_firstCall = false;
+            filter.biquad.setup(config.filterType, config.filterCutoffHz, dt);
+            filter.biquad.prime(filter.filteredRaw);
+            filter.oneEuro.prime(filter.filteredRaw);
+            filter.activeFilter = config.filterType;
+            filter.firstCall = false;
             return;
     }
 
-    for (int i = 0; i < joy::MAX_AXES; i++) {
-        // Update the low-pass filtered raw value for this axis.
-        g_filteredRaw[i] = lowpassFilter_Joy(g_filteredRaw[i], localState.axes[i], alpha);
+    // 2차 필터: 계수는 설정/dt가 바뀐 경우에만 다시 계산. 다른 필터에서 바뀐 직후에는 그 출력에서 이어 간다
+    bool useEma = config.filterType == FilterType::Ema;
+    if (isBiquadFilter(config.filterType)) {
+        filter.biquad.setup(config.filterType, config.filterCutoffHz, dt);
+        if (!isBiquadFilter(filter.activeFilter)) {
+            filter.biquad.prime(filter.filteredRaw);
+        }
+        filter.biquad.process(localState.axes, filter.filteredRaw);
+    } else if (config.filterType == FilterType::OneEuro) {
+        if (filter.activeFilter != FilterType::OneEuro) {
+            filter.oneEuro.prime(filter.filteredRaw);
+        }
+        filter.oneEuro.process(localState.axes, filter.filteredRaw, dt, config.filterCutoffHz, config.oneEuroBeta,
+                               config.oneEuroDCutoffHz, RAW_AXIS_MAX_POS);
+    }
+    filter.activeFilter = config.filterType;
 
-        // Normalize the filtered raw value.
-        float normalized = normalizeAxisValue(g_filteredRaw[i]);
-        
-        // Apply scaling function: dead zone + gradual ramp-up.
-        float scaled = scaleJoystickOutput(normalized, deadZoneThreshold);
-#ifdef CONFIG_USE_SLEW
-        // Limit the rate of change for smoother transitions.
-        float finalOutput = applySlewRate(head_shared.axes[i], scaled, maxDelta);
-        head_shared.axes[i] = finalOutput;
-#else
-        head_shared.axes[i] = scaled;
+#ifdef CONFIG_FIXED_RATE_PIPELINE
+    if (filter.fixedPipeline && dt == FIXED_PIPELINE_DT) {
+        processAxesFixed(localState.axes, filter.filteredRaw, head.axes, elapsed < config.slewSwitchTimeS);
+    } else
 #endif
+    {
+        // Time constant to alpha conversion for EMA filter
+        float alpha = dt / (config.filterTau + dt);
+
+        // Set maxDelta based on max rate per second * dt
+        float maxRate = (elapsed < config.slewSwitchTimeS) ? config.slewInitialMaxRate : config.slewRunningMaxRate;
+        float maxDelta = maxRate * dt;
 
+        // 곡선 계수 등은 설정이 바뀐 뒤 첫 틱에만 만들고, 틱마다 dt에 따라 바뀌는 값만 덮어쓴다
+        AxisPipelineParams &params = filter.params;
+        if (!filter.paramsValid) {
+            params = makeAxisPipelineParams(alpha, deadZoneThreshold, maxDelta, config.useSlew, curves);
+            params.applyLowpass = useEma;
+            filter.paramsValid = true;
+        }
+        params.alpha = alpha;
+        params.maxDelta = maxDelta;
 
+        // 축 파이프라인(필터 → 정규화 → 데드존+곡선 → 슬루)을 8축 한 번에 처리
+        processAxesBatch(localState.axes, filter.filteredRaw, head.axes, params);
     }
+
     for (int i = 0; i < joy::MAX_BUTTONS; i++) {
-        head_shared.buttons[i] = localState.buttons[i];
+        head.buttons[i] = localState.buttons[i];
     }
 }
 
@@ -210,213 +881,1219 @@ void updateSharedState(const JoystickState &localState, float dt, float deadZone
  * @brief updateAccumulators
  *
  * L1/R1, L2/R2 버튼이 눌린 시간만큼 accumStep 단위로 값을 더하거나 빼
- * lr1_accumulated, lr2_accumulated에 누적합니다.
+ * head.lr1_accumulated, head.lr2_accumulated에 누적합니다.
  * 누적값은 –1.0 ~ +1.0 범위로 클램핑됩니다.
  *
- * @param state      현재 버튼 상태가 담긴 구조체
- * @param accumStep  한 스텝당 누적할 양 (초 또는 임의 단위)
+ * @param head   누적값을 갱신할 출력 상태
+ * @param state  현재 버튼 상태가 담긴 구조체
+ * @param dt     직전 틱 이후 경과 시간(초). 한 스텝 누적량 = config.accumRate * dt
+ * @param config 누적 속도와 L1/R1/L2/R2 버튼 인덱스
  */
-void updateAccumulators(const JoystickState &state, float dt) {
-    float accumStep = CONFIG_ACCUM_RATE * dt;
+void updateAccumulators(JoystickState &head, const JoystickState &state, float dt, const JoystickConfig &config) {
+    float accumStep = config.accumRate * dt;
 
-    // L1 (CONFIG_BUTTON_L1) 누르면 감소, R1 누르면 증가
-    if (state.buttons[CONFIG_BUTTON_L1]) {
-        head_shared.lr1_accumulated = std::clamp(head_shared.lr1_accumulated - accumStep, -1.0f, 1.0f);
+    // L1 (config.buttonL1) 누르면 감소, R1 누르면 증가
+    if (state.buttons[config.buttonL1]) {
+        head.lr1_accumulated = std::clamp(head.lr1_accumulated - accumStep, -1.0f, 1.0f);
     }
-    if (state.buttons[CONFIG_BUTTON_R1]) {
-        head_shared.lr1_accumulated = std::clamp(head_shared.lr1_accumulated + accumStep, -1.0f, 1.0f);
+    if (state.buttons[config.buttonR1]) {
+        head.lr1_accumulated = std::clamp(head.lr1_accumulated + accumStep, -1.0f, 1.0f);
     }
 
-    // L2 (CONFIG_BUTTON_L2) 누르면 감소, R2 누르면 증가
-    if (state.buttons[CONFIG_BUTTON_L2]) {
-        head_shared.lr2_accumulated = std::clamp(head_shared.lr2_accumulated - accumStep, -1.0f, 1.0f);
+    // L2 (config.buttonL2) 누르면 감소, R2 누르면 증가
+    if (state.buttons[config.buttonL2]) {
+        head.lr2_accumulated = std::clamp(head.lr2_accumulated - accumStep, -1.0f, 1.0f);
     }
-    if (state.buttons[CONFIG_BUTTON_R2]) {
-        head_shared.lr2_accumulated = std::clamp(head_shared.lr2_accumulated + accumStep, -1.0f, 1.0f);
+    if (state.buttons[config.buttonR2]) {
+        head.lr2_accumulated = std::clamp(head.lr2_accumulated + accumStep, -1.0f, 1.0f);
     }
 }
 
 
-/*
-   runJoystickThread() reads raw joystick events and processes them:
-   - Raw event data is stored in a local JoystickState structure.
-   - For each event, if it's an axis event, its raw value is stored.
-   - Finally, updateSharedState() is called to process axis data.
-*/
+// ─────────────────────────────────────────────────────────────────────────────
+// JoystickDevice
+// ─────────────────────────────────────────────────────────────────────────────
+
+static long futexWait(std::atomic<uint32_t> *word, uint32_t expected, const struct timespec *timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+static void futexWakeAll(std::atomic<uint32_t> *word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// 발행 정보(sequence, 시각)를 뺀 출력 내용이 같은지
+static bool sameOutputs(const JoystickState &a, const JoystickState &b) {
+    return std::memcmp(a.axes, b.axes, sizeof(a.axes)) == 0 &&
+           std::memcmp(a.buttons, b.buttons, sizeof(a.buttons)) == 0 &&
+           std::memcmp(&a.lr1_accumulated, &b.lr1_accumulated, sizeof(float)) == 0 &&
+           std::memcmp(&a.lr2_accumulated, &b.lr2_accumulated, sizeof(float)) == 0;
+}
+
+JoystickDevice::JoystickDevice(const char *devicePath, std::atomic<bool> *enabledFlag)
+    : JoystickDevice(defaultJoystickConfig(devicePath), enabledFlag) {
+}
+
+JoystickDevice::JoystickDevice(const JoystickConfig &config, std::atomic<bool> *enabledFlag, const Clock *clock)
+    : backend_(),
+      backendFactory_(),
+      connected_(false),
+      ownInputEnabled_(false),
+      inputEnabled_(enabledFlag ? enabledFlag : &ownInputEnabled_),
+      localState_(),
+      head_(),
+      filter_(),
+      cfg_(config),
+      cfgSequence_(0),
+      clock_(clock ? clock : &systemClock()),
+      startTimeNs_(clock_->nowNs()),
+      nextReconnectNs_(0),
+      nextWaitLogNs_(0),
+      matchedPath_(),
+      initDone_(false),
+      pendingEvents_(0),
+      pendingEventTimeNs_(0),
+      pendingReadTimeNs_(0),
+      lastEventTimeNs_(0),
+      lastPublished_(),
+      killPressed_(false),
+      published_(),
+      updateWord_(0),
+      updateWaiters_(0),
+      updateEventFd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      updateEventFdUsed_(false),
+      buttonEdges_(),
+      recorder_(new InputRecorder()),
+      sharedState_(new SharedStatePublisher()),
+      config_(config),
+      lastTickEvents_(0),
+      maxTickEvents_(0),
+      totalEvents_(0),
+      ticks_(0),
+      missedTicks_(0),
+      lastInputLatencyNs_(0),
+      maxInputLatencyNs_(0),
+      inputLatency_(),
+      processLatency_(),
+      readLatency_(),
+      lastReadSequence_(0) {
+    resetFilterState(filter_);
+    filter_.slewElapsedS = 0.0f;
+    filter_.fixedPipeline = matchesFixedPipeline(cfg_);
+    filter_.paramsValid = false;
+    cfgSequence_ = config_.sequence();
+    applySharedStateConfig();
+}
+
+JoystickDevice::~JoystickDevice() {
+    close();
+    if (updateEventFd_ >= 0) {
+        ::close(updateEventFd_);
+    }
+}
+
+std::string JoystickDevice::devicePath() const {
+    return config_.load().devicePath;
+}
+
+JoystickState JoystickDevice::getState() const {
+    JoystickState state = published_.load();
+    noteRead(state);
+    return state;
+}
+
 /**
- * @brief runJoystickThread
- *
- * 논블록킹으로 조이스틱 이벤트(/dev/input/js0)를 읽어
- * 1) 축/버튼 이벤트를 localState에 저장
- * 2) updateAccumulators 호출해 버튼 누적값 갱신
- * 3) updateSharedState 호출해 축 값 필터·정규화·스케일링·슬루 적용
- * 4) CONFIG_JOYSTICK_HZ 주파수로 루프
- *
- * 외부에서 continueJoystickThread를 false로 바꾸면
- * 디바이스를 close하고 함수가 종료됩니다.
+ * @brief noteRead
  *
- * @param continueJoystickThread  루프 동작 제어 변수
+ * 발행된 상태를 어느 소비자든 처음 읽은 순간 (지금 - publishTimeNs)를 기록합니다.
+ * 같은 상태를 다시 읽는 대부분의 호출은 공유 변수를 읽기만 하므로 reader끼리 캐시 라인을
+ * 주고받지 않습니다. sequence가 앞으로만 가도록 CAS로 갱신해 한 발행이 두 번 기록되지 않습니다.
  */
-void runJoystickThread(bool &continueJoystickThread) {
-    const char* devicePath = CONFIG_JOYSTICK_DEVICE;  
-    int fd = open(devicePath, O_RDONLY | O_NONBLOCK);
-    if (fd < 0) {
-        std::cerr << ANSI_COLOR_RED << "[JoyStick] Unable to open joystick device: " << devicePath << ANSI_COLOR_RESET << std::endl;
-        return;
-    }
-    
-    std::cout << ANSI_COLOR_GREEN << "[JoyStick] device " << devicePath << " connected successfully" << ANSI_COLOR_RESET << std::endl;
-    
-    struct js_event event;
-    
-    // Low-pass filter coefficient and dead zone threshold
-    float deadZoneThreshold = CONFIG_DEFAULT_DEADZONE;  // Dead zone threshold (user-defined)
-    
-    // localState: holds raw axis and button data (as float for axes)
-    JoystickState localState = {0};
-    
-    // 원하는 루프 주기 계산 (마이크로초 단위)
-    const long DESIRED_LOOP_US = 1000000 / CONFIG_JOYSTICK_HZ; 
-
-    auto startTime = std::chrono::steady_clock::now();
-    bool initDone = false;
-
-    auto last_time = std::chrono::steady_clock::now();
-
-    while (continueJoystickThread) {
-        // 루프 시작 시각 기록  
-        auto loop_start = std::chrono::steady_clock::now();
-        float dt = std::chrono::duration_cast<std::chrono::microseconds>(loop_start - last_time).count() / 1000000.0f;
-        last_time = loop_start;
-
-        ssize_t bytes = read(fd, &event, sizeof(event));
-        
-        // 1. 디스커넥트 처리 (Issue 1)
-        if (bytes < 0 && errno != EAGAIN) {
-            std::cerr << ANSI_COLOR_RED << "[JoyStick] [CRITICAL] Joystick disconnected! Stopping robot." << ANSI_COLOR_RESET << std::endl;
-            close(fd);
-            fd = -1;
-
-            // 상태 초기화
-            localState = {0};
-            {
-                std::lock_guard<std::mutex> lock(joystick_mutex);
-                float saved_lr1 = head_shared.lr1_accumulated;
-                float saved_lr2 = head_shared.lr2_accumulated;
-                head_shared = {0};
-                head_shared.lr1_accumulated = saved_lr1;
-                head_shared.lr2_accumulated = saved_lr2;
-                // 필터 잔상 제거: 재연결 시 직전 방향으로 튀는 것 방지
-                resetFilterState();
-            }
-            inputEnabled.store(false);
-            initDone = false;
-
-            // 재연결 대기
-            while (continueJoystickThread && fd < 0) {
-                std::cout << ANSI_COLOR_YELLOW << "[JoyStick] Waiting for joystick reconnection..." << ANSI_COLOR_RESET << std::endl;
-                usleep(1000000); // 1초 대기
-                fd = open(devicePath, O_RDONLY | O_NONBLOCK);
-            }
-            if (fd >= 0) {
-                std::cout << ANSI_COLOR_GREEN << "[JoyStick] [INFO] Joystick reconnected!" << ANSI_COLOR_RESET << std::endl;
-                startTime = std::chrono::steady_clock::now();
-                last_time = std::chrono::steady_clock::now();
-            }
-            continue;
+void JoystickDevice::noteRead(const JoystickState &state) const {
+    uint64_t seen = lastReadSequence_.load(std::memory_order_relaxed);
+    while (state.sequence > seen) {
+        if (lastReadSequence_.compare_exchange_weak(seen, state.sequence, std::memory_order_relaxed)) {
+            readLatency_.record(clock_->nowNs() - state.publishTimeNs);
+            return;
         }
+    }
+}
 
-        if (bytes == sizeof(event)) {
-            unsigned char type = event.type & ~JS_EVENT_INIT;
-            if (type == JS_EVENT_AXIS) {
-                int axis_index = event.number;
-                if (axis_index < MAX_AXES) {
-                    // Store the raw value (as float) from the event.
-                    localState.axes[axis_index] = static_cast<float>(event.value);
-#ifdef CONFIG_DATA_PRINT
-                    std::cout << "Axis " << axis_index 
-                              << " raw: " << event.value << std::endl;
-#endif
-                }
-            } else if (type == JS_EVENT_BUTTON) {
-                int button_index = event.number;
-                if (button_index < MAX_BUTTONS) {
-                    localState.buttons[button_index] = event.value;
-#ifdef CONFIG_DATA_PRINT
-                    std::cout << "Button " << button_index 
-                              << " state: " << event.value << std::endl;
-#endif
-                }
-            }
+/**
+ * @brief waitForUpdate
+ *
+ * 발행 측은 updateWord_를 올린 뒤 잠든 소비자가 있을 때만 FUTEX_WAKE를 호출하므로,
+ * 기다리는 소비자가 없으면 발행 비용은 atomic 연산 두 번뿐입니다.
+ * 소비자는 워드를 먼저 읽고 상태를 확인한 다음 그 워드 값으로 잠들기 때문에,
+ * 확인과 잠들기 사이에 발행이 끼어들면 futex가 바로 반환되어 알림을 놓치지 않습니다.
+ */
+bool JoystickDevice::waitForUpdate(uint64_t lastSequence, JoystickState &state, int timeoutMs) const {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+    while (true) {
+        uint32_t word = updateWord_.load();
+        state = published_.load();
+        if (state.sequence != lastSequence) {
+            noteRead(state);
+            return true;
         }
 
-        // 2. Kill Switch (비상 정지) 처리 (Issue 3)
-        if (localState.buttons[CONFIG_BUTTON_KILL] == 1) {
-            if (inputEnabled.load()) {
-                std::cerr << ANSI_COLOR_RED << "[JoyStick] [WARNING] Kill Switch (SELECT) Pressed! Disabling inputs." << ANSI_COLOR_RESET << std::endl;
-            }
-            inputEnabled.store(false);
-            initDone = false;
-            localState = {0};
-            {
-                std::lock_guard<std::mutex> lock(joystick_mutex);
-                float saved_lr1 = head_shared.lr1_accumulated;
-                float saved_lr2 = head_shared.lr2_accumulated;
-                head_shared = {0};
-                head_shared.lr1_accumulated = saved_lr1;
-                head_shared.lr2_accumulated = saved_lr2;
-                // 필터 잔상 제거: 재활성화 시 직전 방향으로 튀는 것 방지
-                resetFilterState();
+        struct timespec remaining = {};
+        if (timeoutMs >= 0) {
+            auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) {
+                return false;
             }
+            remaining.tv_sec  = static_cast<time_t>(left / 1000000000LL);
+            remaining.tv_nsec = static_cast<long>(left % 1000000000LL);
         }
-        
-        // 2) initDone 전에는 START 버튼만 복사
-        if (!initDone) {
-            std::lock_guard<std::mutex> lock(joystick_mutex);
-            head_shared.buttons[CONFIG_BUTTON_START] = localState.buttons[CONFIG_BUTTON_START];
-        }
-
-        // 3) 초기화 완료 조건: CONFIG_INIT_DELAY_SEC 경과 + START 버튼 눌림
-        if (!initDone) {
-            float elapsed_init = std::chrono::duration_cast<std::chrono::seconds>(
-                                 std::chrono::steady_clock::now() - startTime
-                             ).count();
-            
-            bool start_pressed = false;
-            {
-                std::lock_guard<std::mutex> lock(joystick_mutex);
-                start_pressed = (head_shared.buttons[CONFIG_BUTTON_START] == 1);
-            }
+        updateWaiters_.fetch_add(1);
+        futexWait(&updateWord_, word, timeoutMs >= 0 ? &remaining : nullptr);
+        updateWaiters_.fetch_sub(1);
+    }
+}
 
-            if (elapsed_init >= CONFIG_INIT_DELAY_SEC && start_pressed)
-            {
-                inputEnabled.store(true);
-                initDone = true;
-                std::cout << ANSI_COLOR_GREEN << "[JoyStick] [INFO] Joystick enabled after START pressed." << ANSI_COLOR_RESET << "\n";
-            }
-        }
+int JoystickDevice::updateFd() {
+    updateEventFdUsed_.store(true);
+    return updateEventFd_;
+}
 
-        // **입력 허용 플래그가 true일 때만 실제 반영**  
-        if (inputEnabled.load()) {
-            std::lock_guard<std::mutex> lock(joystick_mutex);
-            updateAccumulators(localState, dt);
-            // Process the raw axis data: apply filtering, normalization, scaling, and slew rate limiting.
-            updateSharedState(localState, dt, deadZoneThreshold);
-        }
+ButtonEdgeCursor JoystickDevice::buttonEdgeCursor() const {
+    return buttonEdges_.cursor();
+}
 
-        // 루프 종료 시각 기록
-        auto loop_end = std::chrono::steady_clock::now();
-        // 실제 걸린 시간(마이크로초)
-        auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(loop_end - loop_start).count();
-        
-        // 남은 시간만큼 sleep
-        long remaining = DESIRED_LOOP_US - elapsed_us;
-        if (remaining > 0) {
-            usleep(remaining);
-        }
+size_t JoystickDevice::readButtonEdges(ButtonEdgeCursor &cursor, ButtonEdge *out, size_t maxEdges) const {
+    return buttonEdges_.read(cursor, out, maxEdges);
+}
+
+bool JoystickDevice::startRecording(const char *path, std::string *error) {
+    return recorder_->start(path, config_.load(), error);
+}
+
+void JoystickDevice::stopRecording() {
+    recorder_->stop();
+}
+
+bool JoystickDevice::isRecording() const {
+    return recorder_->isRecording();
+}
+
+JoystickStats JoystickDevice::getStats() const {
+    JoystickStats stats;
+    stats.lastTickEvents = lastTickEvents_.load(std::memory_order_relaxed);
+    stats.maxTickEvents  = maxTickEvents_.load(std::memory_order_relaxed);
+    stats.totalEvents    = totalEvents_.load(std::memory_order_relaxed);
+    stats.ticks          = ticks_.load(std::memory_order_relaxed);
+    stats.missedTicks    = missedTicks_.load(std::memory_order_relaxed);
+    stats.lastInputLatencyNs = lastInputLatencyNs_.load(std::memory_order_relaxed);
+    stats.maxInputLatencyNs  = maxInputLatencyNs_.load(std::memory_order_relaxed);
+    stats.droppedRecords     = recorder_->droppedRecords();
+    return stats;
+}
+
+JoystickLatency JoystickDevice::getLatency() const {
+    JoystickLatency latency;
+    latency.input   = inputLatency_.snapshot();
+    latency.process = processLatency_.snapshot();
+    latency.read    = readLatency_.snapshot();
+    return latency;
+}
+
+void JoystickDevice::resetLatency() {
+    inputLatency_.reset();
+    processLatency_.reset();
+    readLatency_.reset();
+}
+
+bool JoystickDevice::isInputEnabled() const {
+    return inputEnabled_->load();
+}
+
+bool JoystickDevice::isConnected() const {
+    return connected_.load();
+}
+
+void JoystickDevice::setAxisCurve(int axis, const ResponseCurve &curve) {
+    if (axis < 0 || axis >= MAX_AXES) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(configWriteMutex_);
+    JoystickConfig config = config_.load();
+    config.curves.axes[axis] = curve;
+    config_.store(config);
+}
+
+ResponseCurve JoystickDevice::getAxisCurve(int axis) const {
+    if (axis < 0 || axis >= MAX_AXES) {
+        return makeResponseCurve(CONFIG_RESPONSE_CURVE, CONFIG_CURVE_EXPO);
+    }
+    return config_.load().curves.axes[axis];
+}
+
+JoystickConfig JoystickDevice::getConfig() const {
+    return config_.load();
+}
+
+/**
+ * @brief setConfig
+ *
+ * 설정을 검사한 뒤 seqlock으로 발행합니다. 작업 스레드는 다음 틱 시작 시
+ * 시퀀스가 바뀐 것을 보고 사본을 갱신하므로 틱 도중에 설정이 섞이지 않습니다.
+ * 장치 경로가 바뀌면 기존 장치를 닫고 곧바로 새 경로로 다시 엽니다.
+ */
+bool JoystickDevice::setConfig(const JoystickConfig &config, std::string *error) {
+    if (!validateJoystickConfig(config, error)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(configWriteMutex_);
+    config_.store(config);
+    return true;
+}
+
+bool JoystickDevice::loadConfig(const char *path, std::string *error) {
+    std::lock_guard<std::mutex> lock(configWriteMutex_);
+    JoystickConfig config = config_.load();
+    if (!parseJoystickConfigFile(path, config, error)) {
+        return false;
+    }
+    config_.store(config);
+    return true;
+}
+
+int JoystickDevice::loopHz() const {
+    return cfg_.loopHz;
+}
+
+// 발행된 설정이 바뀌었으면 작업용 사본을 갱신 (작업 스레드에서만 호출)
+void JoystickDevice::refreshConfig() {
+    uint32_t sequence = config_.sequence();
+    if (sequence == cfgSequence_) {
+        return;
+    }
+    JoystickConfig previous = cfg_;
+    cfg_ = config_.load();
+    cfgSequence_ = sequence;
+    filter_.fixedPipeline = matchesFixedPipeline(cfg_);
+    filter_.paramsValid = false;
+
+    bool reopen = std::strncmp(previous.devicePath, cfg_.devicePath, CONFIG_PATH_MAX) != 0 ||
+                  std::strncmp(previous.deviceName, cfg_.deviceName, CONFIG_PATH_MAX) != 0 ||
+                  previous.vendorId != cfg_.vendorId || previous.productId != cfg_.productId ||
+                  previous.backend != cfg_.backend;
+    if (reopen) {
+        matchedPath_.clear();
+    }
+    if (std::strncmp(previous.sharedMemoryName, cfg_.sharedMemoryName, CONFIG_PATH_MAX) != 0) {
+        applySharedStateConfig();
+    }
+    if (reopen && fd() >= 0) {
+        std::cout << ANSI_COLOR_YELLOW << "[JoyStick] device changed: " << previous.devicePath
+                  << " -> " << cfg_.devicePath << ANSI_COLOR_RESET << std::endl;
+        resetToDisconnected();
+        nextReconnectNs_ = clock_->nowNs();  // 다음 재연결 시도에서 바로 연다
+    }
+}
+
+void JoystickDevice::applySharedStateConfig() {
+    if (cfg_.sharedMemoryName[0] == '\0') {
+        sharedState_->close();
+        return;
+    }
+    std::string error;
+    if (!sharedState_->open(cfg_.sharedMemoryName, &error)) {
+        std::cerr << ANSI_COLOR_RED << "[JoyStick] " << error << ANSI_COLOR_RESET << std::endl;
+        return;
+    }
+    if (lastPublished_.sequence != 0) {
+        sharedState_->publish(lastPublished_);  // 새로 붙은 reader가 다음 발행 전에도 최신 상태를 보도록
+    }
+}
+
+bool JoystickDevice::open() {
+    refreshConfig();
+    if (backendFactory_) {
+        return openBackend(backendFactory_(cfg_), cfg_.devicePath);
+    }
+    const char *path = resolveDevicePath();
+    if (path == nullptr) {
+        return false;
+    }
+    return openBackend(makeInputBackend(cfg_.backend, path), path);
+}
+
+bool JoystickDevice::open(std::unique_ptr<InputBackend> backend) {
+    refreshConfig();
+    return openBackend(std::move(backend), cfg_.devicePath);
+}
+
+/**
+ * @brief resolveDevicePath
+ *
+ * 설정에 장치 이름/ID가 없으면 설정 경로를 그대로 씁니다.
+ * 있으면 마지막에 찾은 노드 → 설정 경로 → 같은 디렉터리의 다른 노드 순으로 열어 보고
+ * 식별 정보가 맞는 첫 노드를 돌려줍니다. 찾은 노드는 캐시해 두므로 같은 자리로 돌아온
+ * 패드는 노드 하나만 확인하고 열며, js0 → js1처럼 옮겨 간 패드는 훑어서 찾습니다.
+ */
+const char *JoystickDevice::resolveDevicePath() {
+    if (!hasDeviceIdentity(cfg_)) {
+        return cfg_.devicePath;
+    }
+    InputDeviceIdentity identity;
+    if (!matchedPath_.empty() && readInputDeviceIdentity(matchedPath_.c_str(), identity) &&
+        matchesDeviceIdentity(cfg_, identity)) {
+        return matchedPath_.c_str();
+    }
+    std::string found;
+    if (readInputDeviceIdentity(cfg_.devicePath, identity) && matchesDeviceIdentity(cfg_, identity)) {
+        found = cfg_.devicePath;
+    } else if (!findInputDevice(cfg_, found)) {
+        return nullptr;
+    }
+    if (found != matchedPath_ && found != cfg_.devicePath) {
+        std::cout << ANSI_COLOR_YELLOW << "[JoyStick] device " << cfg_.devicePath << " matched at " << found << ANSI_COLOR_RESET << std::endl;
+    }
+    matchedPath_ = found;
+    return matchedPath_.c_str();
+}
+
+bool JoystickDevice::openBackend(std::unique_ptr<InputBackend> backend, const char *path) {
+    if (!backend) {
+        return false;
+    }
+    backend_ = std::move(backend);
+    backend_->setRecorder(recorder_.get());
+    if (!backend_->open(path)) {
+        backend_.reset();
+        return false;
+    }
+    connected_.store(true);
+    startTimeNs_ = clock_->nowNs();
+    std::cout << ANSI_COLOR_GREEN << "[JoyStick] device " << path << " connected successfully (" << backend_->name() << ")" << ANSI_COLOR_RESET << std::endl;
+    return true;
+}
+
+void JoystickDevice::setBackendFactory(InputBackendFactory factory) {
+    backendFactory_ = std::move(factory);
+}
+
+void JoystickDevice::close() {
+    backend_.reset();
+    connected_.store(false);
+}
+
+int JoystickDevice::fd() const {
+    return backend_ ? backend_->fd() : -1;
+}
+
+/**
+ * @brief readPendingEvents
+ *
+ * 입력 백엔드로 큐를 비우고 결과를 누적합니다.
+ * 이벤트 구동 모드에서는 한 틱 사이에 여러 번 불릴 수 있습니다.
+ *
+ * @return 디바이스가 끊어졌으면 false
+ */
+bool JoystickDevice::readPendingEvents() {
+    InputDrainResult result;
+    bool connected = backend_->drain(localState_, cfg_.buttonKill, &buttonEdges_, result);
+    pendingEvents_ += result.events;
+    killPressed_ = killPressed_ || result.killPressed;
+    if (result.events > 0) {
+        pendingReadTimeNs_ = clock_->nowNs();
+    }
+    if (result.eventTimeNs > 0) {
+        pendingEventTimeNs_ = result.eventTimeNs;
+        lastEventTimeNs_ = result.eventTimeNs;
+    } else if (result.events > 0) {
+        lastEventTimeNs_ = pendingReadTimeNs_;  // 커널 타임스탬프가 없으면 읽은 시각
+        pendingEventTimeNs_ = lastEventTimeNs_;
+    }
+    return connected;
+}
+
+// raw 상태를 0으로. 버튼 edge 스트림이 buttons[] 값과 어긋나지 않도록 눌려 있던 버튼은 뗌으로 기록
+void JoystickDevice::clearLocalState() {
+    int64_t now = clock_->nowNs();
+    for (int i = 0; i < MAX_BUTTONS; ++i) {
+        if (localState_.buttons[i]) {
+            buttonEdges_.push(ButtonEdge{now, static_cast<uint32_t>(i), 0u});
+        }
+    }
+    localState_ = {};
+}
+
+// 누적기를 제외한 출력과 필터 상태를 0으로 초기화하고 발행
+void JoystickDevice::resetOutputs() {
+    float saved_lr1 = head_.lr1_accumulated;
+    float saved_lr2 = head_.lr2_accumulated;
+    head_ = {};
+    head_.lr1_accumulated = saved_lr1;
+    head_.lr2_accumulated = saved_lr2;
+    // 필터 잔상 제거: 재활성화/재연결 시 직전 방향으로 튀는 것 방지
+    resetFilterState(filter_);
+    publishState();
+}
+
+/**
+ * @brief handleKillSwitch
+ *
+ * Kill Switch가 눌렸으면 입력을 비활성화하고 출력과 필터 상태를 0으로 초기화합니다.
+ * 누적기 값은 유지합니다.
+ */
+void JoystickDevice::handleKillSwitch() {
+    if (!killPressed_ && localState_.buttons[cfg_.buttonKill] != 1) {
+        return;
+    }
+    killPressed_ = false;
+
+    if (inputEnabled_->load()) {
+        std::cerr << ANSI_COLOR_RED << "[JoyStick] [WARNING] Kill Switch (SELECT) Pressed! Disabling inputs." << ANSI_COLOR_RESET << std::endl;
+    }
+    inputEnabled_->store(false);
+    initDone_ = false;
+    clearLocalState();
+    resetOutputs();
+}
+
+/**
+ * @brief handleDisconnect
+ *
+ * 디바이스를 닫고 출력/필터 상태를 0으로 초기화합니다.
+ * 재연결은 JoystickManager가 tryReconnect()로 시도합니다.
+ */
+void JoystickDevice::handleDisconnect() {
+    std::cerr << ANSI_COLOR_RED << "[JoyStick] [CRITICAL] Joystick " << cfg_.devicePath << " disconnected! Stopping robot." << ANSI_COLOR_RESET << std::endl;
+    resetToDisconnected();
+    nextReconnectNs_ = clock_->nowNs() + RECONNECT_INTERVAL_NS;
+}
+
+/**
+ * @brief resetToDisconnected
+ *
+ * 디바이스를 닫고 raw/출력/필터 상태를 0으로, 입력을 비활성화합니다 (로그 없음).
+ * 다시 열면 초기화 게이팅(initDelaySec + START 버튼)부터 다시 시작합니다.
+ * 끊김 처리, 장치 변경, 작업 루프 종료(JoystickService::stop)에서 공통으로 씁니다.
+ */
+void JoystickDevice::resetToDisconnected() {
+    close();
+    clearLocalState();
+    pendingEvents_ = 0;
+    pendingEventTimeNs_ = 0;
+    pendingReadTimeNs_ = 0;
+    killPressed_ = false;
+    resetOutputs();
+    inputEnabled_->store(false);
+    initDone_ = false;
+}
+
+/**
+ * @brief tryReconnect
+ *
+ * 끊어진 장치를 RECONNECT_INTERVAL_NS 간격으로 다시 열어 봅니다.
+ * 재연결에 성공하면 초기화 게이팅을 다시 시작합니다.
+ *
+ * @return 이번 호출에서 재연결에 성공했으면 true
+ */
+bool JoystickDevice::tryReconnect() {
+    int64_t now = clock_->nowNs();
+    if (now < nextReconnectNs_) {
+        return false;
+    }
+    nextReconnectNs_ = now + RECONNECT_INTERVAL_NS;
+
+    // 시도는 1초마다(핫플러그면 더 자주) 하지만 로그는 RECONNECT_LOG_INTERVAL_NS에 한 번만
+    if (now >= nextWaitLogNs_) {
+        std::cout << ANSI_COLOR_YELLOW << "[JoyStick] Waiting for joystick " << cfg_.devicePath << " reconnection..." << ANSI_COLOR_RESET << std::endl;
+        nextWaitLogNs_ = now + RECONNECT_LOG_INTERVAL_NS;
+    }
+    if (!open()) {
+        return false;
+    }
+    nextWaitLogNs_ = 0;  // 다음에 끊어지면 바로 로그
+    std::cout << ANSI_COLOR_GREEN << "[JoyStick] [INFO] Joystick reconnected!" << ANSI_COLOR_RESET << std::endl;
+    return true;
+}
+
+void JoystickDevice::requestReconnect() {
+    nextReconnectNs_ = clock_->nowNs();
+}
+
+void JoystickDevice::noteHotplugNode(const std::string &dir, const char *name) {
+    if (fd() >= 0) {
+        return;
+    }
+    if (name == nullptr || isDeviceNodeCandidate(cfg_, dir, name)) {
+        requestReconnect();
+    }
+}
+
+void JoystickDevice::recordMissedTicks(uint64_t missed) {
+    missedTicks_.fetch_add(missed, std::memory_order_relaxed);
+}
+
+/**
+ * @brief publishState
+ *
+ * head_를 외부에 발행합니다 (작업 스레드에서만 호출).
+ * 출력 내용이 직전 발행과 같으면 아무것도 하지 않으므로, 소비자는 sequence가
+ * 그대로면 바뀐 것이 없다고 보고 처리를 건너뛸 수 있습니다.
+ * (필터가 수렴하는 동안에는 값이 계속 조금씩 변하므로 매 틱 발행됩니다.)
+ */
+void JoystickDevice::publishState() {
+    if (lastPublished_.sequence != 0 && sameOutputs(head_, lastPublished_)) {
+        return;
+    }
+    head_.sequence      = lastPublished_.sequence + 1;
+    head_.eventTimeNs   = lastEventTimeNs_;
+    head_.publishTimeNs = clock_->nowNs();
+    published_.store(head_);
+    sharedState_->publish(head_);
+    lastPublished_ = head_;
+    recorder_->recordState(head_);
+
+    // 대기 중인 소비자 깨우기
+    updateWord_.fetch_add(1);
+    if (updateWaiters_.load() > 0) {
+        futexWakeAll(&updateWord_);
+    }
+    if (updateEventFdUsed_.load(std::memory_order_relaxed) && updateEventFd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(updateEventFd_, &one, sizeof(one));
+        (void)written;  // 카운터가 넘치면(EAGAIN) 이미 readable이므로 무시
+    }
+}
+
+/**
+ * @brief tick
+ *
+ * 고정 주기마다 한 번씩 호출되어
+ * 0) 바뀐 설정이 있으면 반영
+ * 1) 틱 통계 갱신
+ * 2) Kill Switch 처리
+ * 3) 초기화 게이팅 (initDelaySec 경과 + START 버튼)
+ * 4) 입력이 허용된 경우 updateAccumulators / updateSharedState
+ * 를 수행하고 결과를 발행합니다.
+ */
+void JoystickDevice::tick(float dt) {
+    refreshConfig();
+
+    uint32_t coalesced = pendingEvents_;
+    pendingEvents_ = 0;
+    lastTickEvents_.store(coalesced, std::memory_order_relaxed);
+    if (coalesced > maxTickEvents_.load(std::memory_order_relaxed)) {
+        maxTickEvents_.store(coalesced, std::memory_order_relaxed);
+    }
+    totalEvents_.fetch_add(coalesced, std::memory_order_relaxed);
+    ticks_.fetch_add(1, std::memory_order_relaxed);
+
+    // 2. Kill Switch (비상 정지) 처리 (Issue 3)
+    handleKillSwitch();
+
+    // 2) initDone 전에는 START 버튼만 복사
+    if (!initDone_) {
+        head_.buttons[cfg_.buttonStart] = localState_.buttons[cfg_.buttonStart];
+    }
+
+    // 3) 초기화 완료 조건: initDelaySec 경과 + START 버튼 눌림
+    if (!initDone_) {
+        float elapsed_init = (clock_->nowNs() - startTimeNs_) / 1000000000.0f;
+
+        bool start_pressed = (head_.buttons[cfg_.buttonStart] == 1);
+
+        if (elapsed_init >= cfg_.initDelaySec && start_pressed)
+        {
+            inputEnabled_->store(true);
+            initDone_ = true;
+            std::cout << ANSI_COLOR_GREEN << "[JoyStick] [INFO] Joystick " << cfg_.devicePath << " enabled after START pressed." << ANSI_COLOR_RESET << "\n";
+        }
+    }
+
+    // **입력 허용 플래그가 true일 때만 실제 반영**  
+    if (inputEnabled_->load()) {
+        updateAccumulators(head_, localState_, dt, cfg_);
+        // Process the raw axis data: apply filtering, normalization, scaling, and slew rate limiting.
+        updateSharedState(head_, filter_, localState_, dt, cfg_);
+    }
+
+    // 틱 결과를 한 번에 발행
+    publishState();
+
+    // 입력 지연: 이번 틱에 반영된 마지막 이벤트의 시각 → 발행 직후 (process: 읽은 시각 → 발행 직후)
+    if (pendingReadTimeNs_ > 0) {
+        processLatency_.record(clock_->nowNs() - pendingReadTimeNs_);
+        pendingReadTimeNs_ = 0;
+    }
+    if (pendingEventTimeNs_ > 0) {
+        int64_t latency = clock_->nowNs() - pendingEventTimeNs_;
+        pendingEventTimeNs_ = 0;
+        inputLatency_.record(latency);
+        lastInputLatencyNs_.store(latency, std::memory_order_relaxed);
+        if (latency > maxInputLatencyNs_.load(std::memory_order_relaxed)) {
+            maxInputLatencyNs_.store(latency, std::memory_order_relaxed);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JoystickManager
+// ─────────────────────────────────────────────────────────────────────────────
+
+// timespec에 나노초를 더한다 (tv_nsec 정규화 포함)
+static void addNanoseconds(struct timespec &ts, long long ns) {
+    long long total = static_cast<long long>(ts.tv_nsec) + ns;
+    ts.tv_sec  += static_cast<time_t>(total / 1000000000LL);
+    ts.tv_nsec  = static_cast<long>(total % 1000000000LL);
+}
+
+// a - b (나노초)
+static long long diffNanoseconds(const struct timespec &a, const struct timespec &b) {
+    return (static_cast<long long>(a.tv_sec) - b.tv_sec) * 1000000000LL + (a.tv_nsec - b.tv_nsec);
+}
+
+JoystickManager::JoystickManager()
+    : stopRequested_(false),
+      stopFd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      legacyFlag_(nullptr) {
+}
+
+JoystickManager::~JoystickManager() {
+    if (stopFd_ >= 0) {
+        ::close(stopFd_);
+    }
+}
+
+void JoystickManager::requestStop() {
+    stopRequested_.store(true);
+    if (stopFd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(stopFd_, &one, sizeof(one));
+        (void)written;   // 카운터가 넘칠 때만 실패하며, 이미 readable이므로 무시해도 된다
+    }
+}
+
+void JoystickManager::clearStopRequest() {
+    if (stopFd_ >= 0) {
+        uint64_t count;
+        while (::read(stopFd_, &count, sizeof(count)) == sizeof(count)) {
+        }
+    }
+    stopRequested_.store(false);
+}
+
+// 예전 API의 플래그를 매 틱 확인한다. 사용 중단된 bool& 진입점의 플래그는 atomic load로 읽지만
+// 쓰는 쪽이 일반 대입이면 여전히 data race이므로 그 진입점은 [[deprecated]]로 표시했다.
+bool JoystickManager::keepRunning(const std::atomic<bool> *continueRunning) const {
+    if (stopRequested_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    if (legacyFlag_ != nullptr && !__atomic_load_n(legacyFlag_, __ATOMIC_RELAXED)) {
+        return false;
+    }
+    return continueRunning == nullptr || continueRunning->load(std::memory_order_relaxed);
+}
+
+// 절대 데드라인까지 대기. stop eventfd가 readable이 되면(requestStop) 바로 돌아온다.
+void JoystickManager::waitUntil(const struct timespec &deadline) {
+    if (stopFd_ < 0) {
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+        }
+        return;
+    }
+    struct pollfd pfd = {stopFd_, POLLIN, 0};
+    while (true) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long long left = diffNanoseconds(deadline, now);
+        if (left <= 0) {
+            return;
+        }
+        struct timespec timeout;
+        timeout.tv_sec  = static_cast<time_t>(left / 1000000000LL);
+        timeout.tv_nsec = static_cast<long>(left % 1000000000LL);
+        int result = ppoll(&pfd, 1, &timeout, nullptr);
+        if (result > 0 || (result < 0 && errno != EINTR)) {
+            return;
+        }
+    }
+}
+
+JoystickDevice &JoystickManager::addDevice(const char *devicePath, std::atomic<bool> *enabledFlag) {
+    devices_.emplace_back(new JoystickDevice(devicePath, enabledFlag));
+    return *devices_.back();
+}
+
+JoystickDevice &JoystickManager::addDevice(const JoystickConfig &config, std::atomic<bool> *enabledFlag) {
+    devices_.emplace_back(new JoystickDevice(config, enabledFlag));
+    return *devices_.back();
+}
+
+// 루프 주기 (나노초). 장치마다 loopHz가 다르면 가장 빠른 값을 따른다.
+long long JoystickManager::desiredLoopNs() {
+    int hz = 1;
+    for (auto &dev : devices_) {
+        hz = std::max(hz, dev->loopHz());
+    }
+    if (devices_.empty()) {
+        hz = CONFIG_JOYSTICK_HZ;
+    }
+    return 1000000000LL / hz;
+}
+
+size_t JoystickManager::deviceCount() const {
+    return devices_.size();
+}
+
+JoystickDevice &JoystickManager::device(size_t index) {
+    return *devices_.at(index);
+}
+
+/**
+ * @brief reconnectDevices
+ *
+ * 끊어진 장치마다 tryReconnect를 호출하고, 이벤트 구동 모드(epfd >= 0)라면
+ * 다시 열린 장치를 epoll에 등록합니다.
+ */
+void JoystickManager::reconnectDevices(int epfd) {
+    for (auto &dev : devices_) {
+        if (dev->fd() >= 0) {
+            continue;
+        }
+        if (!dev->tryReconnect()) {
+            continue;
+        }
+        if (epfd >= 0) {
+            struct epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.ptr = dev.get();
+            epoll_ctl(epfd, EPOLL_CTL_ADD, dev->fd(), &ev);
+        }
+    }
+}
+
+/**
+ * @brief handleHotplug
+ *
+ * 쌓인 핫플러그 알림을 비우면서 노드 이름이 장치 경로(식별 정보가 있으면 같은 종류의 노드)와
+ * 맞는 끊어진 장치만 재연결 간격을 기다리지 않게 한 뒤 reconnectDevices를 부릅니다.
+ * 다른 입력 장치(마우스, 키보드)의 알림으로는 장치를 열거나 디렉터리를 훑지 않습니다.
+ */
+void JoystickManager::handleHotplug(int epfd, HotplugWatcher &hotplug) {
+    hotplug.readChanges([this](const std::string &dir, const char *name) {
+        for (auto &dev : devices_) {
+            dev->noteHotplugNode(dir, name);
+        }
+    });
+    reconnectDevices(epfd);
+}
+
+/**
+ * @brief runPollingLoop
+ *
+ * 절대 데드라인 기반 폴링 루프. 매 주기마다 모든 장치의 큐를 비우고 틱을 실행한 뒤
+ * waitUntil로 다음 데드라인까지 대기합니다. 대기는 절대 데드라인에서 남은 시간을 매번 다시 계산해
+ * stop eventfd를 ppoll하며, eventfd를 만들지 못했으면 clock_nanosleep(TIMER_ABSTIME)으로 대신합니다.
+ *
+ * 상대 시간(usleep)으로 남은 시간을 재면 루프 처리 시간과 깨어나는 지연이 누적되어
+ * 주기가 점점 밀리므로, 데드라인을 period 단위로만 전진시켜 평균 주기를 정확히 유지합니다.
+ * 틱이 데드라인을 한 주기 이상 넘기면(overrun) 놓친 틱 수를 기록하고
+ * 데드라인을 현재 시각 이후로 건너뜁니다. 이 경우 dt는 놓친 주기만큼 늘어납니다.
+ * 주기는 매 틱 뒤에 장치 설정(loopHz)으로 다시 계산하므로 실행 중에 바꿀 수 있습니다.
+ * 끊어진 장치가 있는 동안에는 매 틱 핫플러그 알림을 확인합니다 (non-blocking read 한 번).
+ * 대기는 stop eventfd와 함께 하므로 requestStop()이 불리면 데드라인을 기다리지 않고 종료합니다.
+ */
+void JoystickManager::runPollingLoop(const std::atomic<bool> *continueRunning, HotplugWatcher &hotplug) {
+    // 원하는 루프 주기 (나노초 단위)
+    long long loopNs = desiredLoopNs();
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    long long elapsedPeriods = 1;  // 직전 틱 이후 지난 주기 수 (dt = 주기 * elapsedPeriods)
+
+    while (keepRunning(continueRunning)) {
+        float dt = (loopNs / 1000000000.0f) * elapsedPeriods;
+
+        bool disconnected = false;
+        for (auto &dev : devices_) {
+            if (dev->fd() < 0) {
+                disconnected = true;
+                continue;
+            }
+            // 1. 큐에 쌓인 이벤트를 전부 읽어 updateSharedState 전에 반영
+            if (!dev->readPendingEvents()) {
+                // 디스커넥트 처리 (Issue 1)
+                dev->handleDisconnect();
+                disconnected = true;
+                continue;
+            }
+            dev->tick(dt);
+        }
+        if (disconnected) {
+            handleHotplug(-1, hotplug);
+        }
+
+        // 다음 데드라인 계산 및 overrun 검출
+        loopNs = desiredLoopNs();
+        addNanoseconds(deadline, loopNs);
+        elapsedPeriods = 1;
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long long late = diffNanoseconds(now, deadline);
+        if (late >= loopNs) {
+            long long missed = late / loopNs;
+            addNanoseconds(deadline, missed * loopNs);
+            elapsedPeriods += missed;
+            for (auto &dev : devices_) {
+                dev->recordMissedTicks(static_cast<uint64_t>(missed));
+            }
+        }
+
+        // 다음 데드라인까지 대기 (EINTR이면 같은 데드라인으로 재시도, requestStop이면 바로 깨어남)
+        waitUntil(deadline);
+    }
+}
+
+/**
+ * @brief runEventLoop
+ *
+ * epoll 하나로 모든 장치 fd와 timerfd를 함께 대기하는 이벤트 구동 루프.
+ *  - 장치 fd가 readable이 되는 즉시 이벤트를 읽어 반영하고,
+ *    Kill Switch는 틱을 기다리지 않고 바로 처리합니다.
+ *  - 필터/누적기 적분(tick)은 timerfd가 만료될 때마다 장치 설정의 loopHz 주기로 실행합니다.
+ *    틱 뒤에 주기가 바뀐 것을 보면 timerfd를 새 주기로 다시 설정합니다.
+ *  - 핫플러그 알림(inotify)이 끊어진 장치의 노드면 틱을 기다리지 않고 바로 다시 열어 봅니다.
+ *  - stop eventfd가 readable이 되면(requestStop) 바로 빠져나옵니다.
+ *
+ * @return epoll/timerfd 준비에 실패하면 false (호출 측에서 폴링 루프로 대체)
+ */
+bool JoystickManager::runEventLoop(const std::atomic<bool> *continueRunning, HotplugWatcher &hotplug) {
+    int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        return false;
+    }
+    int tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (tfd < 0) {
+        ::close(epfd);
+        return false;
+    }
+
+    // timerfd는 첫 만료 시각을 절대 시간(TFD_TIMER_ABSTIME)으로 잡고 주기로 반복하므로
+    // 처리 시간이 누적되어 주기가 밀리지 않는다. 틱을 놓치면 만료 횟수(expirations)로 알 수 있다.
+    long long loopNs = desiredLoopNs();
+    auto armTimer = [tfd](long long ns) {
+        struct itimerspec period = {};
+        period.it_interval.tv_sec  = static_cast<time_t>(ns / 1000000000LL);
+        period.it_interval.tv_nsec = static_cast<long>(ns % 1000000000LL);
+        clock_gettime(CLOCK_MONOTONIC, &period.it_value);
+        addNanoseconds(period.it_value, ns);
+        return timerfd_settime(tfd, TFD_TIMER_ABSTIME, &period, nullptr) == 0;
+    };
+
+    // timerfd는 data.ptr == nullptr, 핫플러그 fd는 &hotplug, stop eventfd는 &stopFd_,
+    // 장치 fd는 data.ptr == JoystickDevice*
+    struct epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    bool ok = armTimer(loopNs) &&
+              epoll_ctl(epfd, EPOLL_CTL_ADD, tfd, &ev) == 0;
+    if (stopFd_ >= 0) {
+        ev.data.ptr = &stopFd_;
+        ok = ok && epoll_ctl(epfd, EPOLL_CTL_ADD, stopFd_, &ev) == 0;
+    }
+    if (hotplug.fd() >= 0) {
+        ev.data.ptr = &hotplug;
+        ok = ok && epoll_ctl(epfd, EPOLL_CTL_ADD, hotplug.fd(), &ev) == 0;
+    }
+    for (auto &dev : devices_) {
+        if (dev->fd() < 0) {
+            continue;
+        }
+        ev.data.ptr = dev.get();
+        ok = ok && epoll_ctl(epfd, EPOLL_CTL_ADD, dev->fd(), &ev) == 0;
+    }
+    if (!ok) {
+        ::close(tfd);
+        ::close(epfd);
+        return false;
+    }
+
+    constexpr int MAX_READY = 16;
+    struct epoll_event ready[MAX_READY];
+
+    while (keepRunning(continueRunning)) {
+        int n = epoll_wait(epfd, ready, MAX_READY, -1);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << ANSI_COLOR_RED << "[JoyStick] epoll_wait failed, falling back to polling loop" << ANSI_COLOR_RESET << std::endl;
+            break;
+        }
+
+        uint64_t expirations = 0;
+        for (int i = 0; i < n; ++i) {
+            if (ready[i].data.ptr == &stopFd_) {
+                continue;  // requestStop: 읽지 않고 둔다 (clearStopRequest에서 비움). while 조건에서 종료
+            }
+            if (ready[i].data.ptr == &hotplug) {
+                handleHotplug(epfd, hotplug);
+                continue;
+            }
+            JoystickDevice *dev = static_cast<JoystickDevice *>(ready[i].data.ptr);
+            if (dev == nullptr) {
+                if (read(tfd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+                    expirations = 0;
+                }
+                continue;
+            }
+            if (dev->fd() < 0) {
+                continue;  // 같은 epoll_wait 결과 안에서 이미 끊어진 장치
+            }
+
+            // 장치 fd: 도착 즉시 이벤트 반영
+            if (!dev->readPendingEvents()) {
+                // 디스커넥트 처리 (Issue 1). close(fd)로 epoll 등록도 함께 해제된다.
+                dev->handleDisconnect();
+                continue;
+            }
+            dev->handleKillSwitch();
+        }
+
+        if (expirations > 0) {
+            // 만료가 2회 이상이면 그만큼 틱을 놓친 것. dt에 놓친 주기를 포함해 적분량을 보존한다.
+            for (auto &dev : devices_) {
+                if (dev->fd() < 0) {
+                    continue;
+                }
+                if (expirations > 1) {
+                    dev->recordMissedTicks(expirations - 1);
+                }
+                dev->tick((loopNs / 1000000000.0f) * expirations);
+            }
+            reconnectDevices(epfd);
+
+            long long newLoopNs = desiredLoopNs();
+            if (newLoopNs != loopNs && armTimer(newLoopNs)) {
+                loopNs = newLoopNs;
+            }
+        }
+    }
+
+    ::close(tfd);
+    ::close(epfd);
+    // 루프를 정상 종료했거나 에러로 빠져나왔음. 종료 요청이 아니면 폴링으로 계속.
+    return !keepRunning(continueRunning);
+}
+
+void JoystickManager::run() {
+    runLoops(nullptr);
+}
+
+void JoystickManager::run(std::atomic<bool> &continueRunning) {
+    runLoops(&continueRunning);
+}
+
+void JoystickManager::run(bool &continueRunning) {
+    runLoops(nullptr, &continueRunning);
+}
+
+void JoystickManager::runLoops(const std::atomic<bool> *continueRunning, const bool *legacyFlag) {
+    legacyFlag_ = legacyFlag;
+    // 장치 노드가 생기는 디렉터리 감시 (실행 중에 장치 경로를 바꾸면 새 디렉터리는 1초 간격 재연결로만 잡힘)
+    HotplugWatcher hotplug;
+    for (auto &dev : devices_) {
+        hotplug.watchParentOf(dev->devicePath().c_str());
+        if (dev->fd() < 0 && !dev->open()) {
+            std::cerr << ANSI_COLOR_RED << "[JoyStick] Unable to open joystick device: " << dev->devicePath() << ANSI_COLOR_RESET << std::endl;
+        }
+    }
+
+    bool finished = false;
+    if (g_loopMode.load() == LoopMode::EventDriven) {
+        finished = runEventLoop(continueRunning, hotplug);
+        if (!finished) {
+            std::cerr << ANSI_COLOR_YELLOW << "[JoyStick] Event-driven loop unavailable, using polling loop" << ANSI_COLOR_RESET << std::endl;
+        }
+    }
+    if (!finished) {
+        runPollingLoop(continueRunning, hotplug);
+    }
+
+    // 멈춘 뒤에는 직전 스틱 값을 발행하지 않고, 다시 시작하면 START 게이팅부터 밟도록 끊긴 상태로 되돌린다
+    for (auto &dev : devices_) {
+        dev->resetToDisconnected();
+    }
+    legacyFlag_ = nullptr;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// 기본 장치(CONFIG_JOYSTICK_DEVICE) API
+// ─────────────────────────────────────────────────────────────────────────────
+
+// runJoystickThread가 쓰는 기본 매니저. 장치 하나(CONFIG_JOYSTICK_DEVICE)를 가지며
+// 입력 허용 플래그는 전역 inputEnabled를 그대로 사용한다.
+// 프로세스 종료 시 아직 돌고 있는 스레드와 소멸 순서가 꼬이지 않도록 일부러 해제하지 않는다.
+static JoystickManager &defaultManager() {
+    static JoystickManager *manager = [] {
+        JoystickManager *m = new JoystickManager();
+        m->addDevice(CONFIG_JOYSTICK_DEVICE, &inputEnabled);
+        return m;
+    }();
+    return *manager;
+}
+
+JoystickManager &defaultJoystickManager() {
+    return defaultManager();
+}
+
+JoystickState getJoystickState() {
+    return defaultManager().device(0).getState();
+}
+
+JoystickStats getJoystickStats() {
+    return defaultManager().device(0).getStats();
+}
+
+JoystickLatency getJoystickLatency() {
+    return defaultManager().device(0).getLatency();
+}
+
+void resetJoystickLatency() {
+    defaultManager().device(0).resetLatency();
+}
+
+bool startJoystickRecording(const char *path, std::string *error) {
+    return defaultManager().device(0).startRecording(path, error);
+}
+
+void stopJoystickRecording() {
+    defaultManager().device(0).stopRecording();
+}
+
+ButtonEdgeCursor makeButtonEdgeCursor() {
+    return defaultManager().device(0).buttonEdgeCursor();
+}
+
+size_t readButtonEdges(ButtonEdgeCursor &cursor, ButtonEdge *out, size_t maxEdges) {
+    return defaultManager().device(0).readButtonEdges(cursor, out, maxEdges);
+}
+
+bool waitForJoystickUpdate(uint64_t lastSequence, JoystickState &state, int timeoutMs) {
+    return defaultManager().device(0).waitForUpdate(lastSequence, state, timeoutMs);
+}
+
+int getJoystickUpdateFd() {
+    return defaultManager().device(0).updateFd();
+}
+
+void setAxisCurve(int axis, const ResponseCurve &curve) {
+    defaultManager().device(0).setAxisCurve(axis, curve);
+}
+
+ResponseCurve getAxisCurve(int axis) {
+    return defaultManager().device(0).getAxisCurve(axis);
+}
+
+JoystickConfig getJoystickConfig() {
+    return defaultManager().device(0).getConfig();
+}
+
+bool setJoystickConfig(const JoystickConfig &config, std::string *error) {
+    return defaultManager().device(0).setConfig(config, error);
+}
+
+bool reloadJoystickConfig(const char *path, std::string *error) {
+    return defaultManager().device(0).loadConfig(path, error);
+}
+
+void setLoopMode(LoopMode mode) {
+    g_loopMode.store(mode);
+}
+
+LoopMode getLoopMode() {
+    return g_loopMode.load();
+}
+
+// runJoystickThread는 장치를 처음 열지 못하면 루프를 돌지 않고 바로 반환한다
+static bool openDefaultDevice(JoystickManager &manager) {
+    JoystickDevice &device = manager.device(0);
+    if (!device.open()) {
+        std::cerr << ANSI_COLOR_RED << "[JoyStick] Unable to open joystick device: " << device.devicePath() << ANSI_COLOR_RESET << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/*
+   runJoystickThread() reads raw joystick events and processes them:
+   - Raw event data is stored in a local JoystickState structure.
+   - For each event, if it's an axis event, its raw value is stored.
+   - Finally, updateSharedState() is called to process axis data.
+*/
+/**
+ * @brief runJoystickThread
+ *
+ * 논블록킹으로 조이스틱 이벤트(/dev/input/js0)를 읽어
+ * 1) 큐에 쌓인 축/버튼 이벤트를 한 틱에 모두 읽어 localState에 저장
+ * 2) updateAccumulators 호출해 버튼 누적값 갱신
+ * 3) updateSharedState 호출해 축 값 필터·정규화·스케일링·슬루 적용
+ * 4) 설정의 loopHz(기본 CONFIG_JOYSTICK_HZ) 주파수로 루프
+ *
+ * 기본 JoystickManager(장치 CONFIG_JOYSTICK_DEVICE 하나)를 실행합니다.
+ * 루프 방식은 스레드 시작 시점의 getLoopMode()를 따릅니다.
+ *
+ * 외부에서 continueJoystickThread를 false로 바꾸면
+ * 디바이스를 close하고 함수가 종료됩니다.
+ *
+ * @param continueJoystickThread  루프 동작 제어 변수
+ */
+void runJoystickThread(std::atomic<bool> &continueJoystickThread) {
+    JoystickManager &manager = defaultManager();
+    if (!openDefaultDevice(manager)) {
+        return;
+    }
+    manager.run(continueJoystickThread);
+}
+
+// 사용 중단된 bool 플래그 버전 (joystick.h 참고)
+void runJoystickThread(bool &continueJoystickThread) {
+    JoystickManager &manager = defaultManager();
+    if (!openDefaultDevice(manager)) {
+        return;
+    }
+    manager.runLoops(nullptr, &continueJoystickThread);
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// JoystickService
+// ─────────────────────────────────────────────────────────────────────────────
+
+JoystickService::JoystickService() : manager_(defaultManager()) {
+}
+
+JoystickService::JoystickService(JoystickManager &manager) : manager_(manager) {
+}
+
+JoystickService::~JoystickService() {
+    stop();
+}
+
+bool JoystickService::start(const RealtimeOptions &options, std::string *error) {
+    if (thread_.joinable()) {
+        if (error) {
+            *error = "joystick service already running";
+        }
+        return false;
+    }
+    // 이전 stop()의 요청을 지운 뒤 스레드를 만든다 (스레드 시작 직후의 stop()은 그대로 유지된다)
+    manager_.clearStopRequest();
+    return thread_.start([this] { manager_.run(); }, options, error);
+}
+
+void JoystickService::stop() {
+    if (!thread_.joinable()) {
+        return;
     }
-    
-    close(fd);
+    manager_.requestStop();
+    thread_.join();
 }
 
-}  // namespace joy
\ No newline at end of file
+}  // namespace joy
@@ -3,13 +3,29 @@
 
 #include <linux/joystick.h>  // js_event 등 조이스틱 타입 정의
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
+
+#include "axis_filter.h"
+#include "button_edges.h"
+#include "clock.h"
+#include "latency_histogram.h"
+#include "response_curve.h"
+#include "rt_thread.h"
+#include "seqlock.h"
 
 
 
 // =========================================================================================
 // ──  User Configuration Area (사용자 설정 영역)  ───────────────────────────────────────────
 // [설명] 필요에 따라 아래 값들을 자유롭게 변경하세요. (컴파일 시 적용됩니다)
+// 1~8번 값은 런타임 설정(joy::JoystickConfig)의 기본값입니다. 재빌드 없이 바꾸려면
+// 설정 파일을 joy::reloadJoystickConfig()로 읽거나 joy::setJoystickConfig()를 호출하세요.
 // 플레이스테이션 패드 기준 
 // =========================================================================================
 
@@ -19,9 +35,21 @@
 // 1. 조이스틱 장치 경로 (실제 연결된 장치가 js0, js1 인지 확인)
 #define CONFIG_JOYSTICK_DEVICE       "/dev/input/js0"
 
+// 1-1. 장치 식별 (비워 두거나 0이면 경로만 사용)
+// 다시 꽂으면 커널이 js0 대신 js1 같은 다른 노드를 줄 수 있습니다. 이름이나 USB vendor/product ID를
+// 지정하면 장치 경로에 그 패드가 없을 때 같은 디렉터리(/dev/input)를 훑어 같은 패드를 찾아 엽니다.
+#define CONFIG_DEVICE_NAME           ""      // JSIOCGNAME / EVIOCGNAME 이름 (예: "Sony Interactive Entertainment Wireless Controller")
+#define CONFIG_DEVICE_VENDOR_ID      0x0000  // USB vendor ID (예: 0x054c)
+#define CONFIG_DEVICE_PRODUCT_ID     0x0000  // USB product ID (예: 0x09cc)
+
 // 2. 조이스틱 읽기 루프 주파수 (Hz 단위, 1000 = 1ms 주기)
 #define CONFIG_JOYSTICK_HZ           100
 
+// 2-1. 루프 방식 기본값 (setLoopMode()로 런타임에 변경 가능)
+// joy::LoopMode::Polling     : 매 주기 절대 데드라인까지 stop eventfd를 ppoll하며 대기한 뒤 이벤트를 읽음
+// joy::LoopMode::EventDriven : epoll로 이벤트 도착 즉시 읽고, 필터 틱은 timerfd로 고정 주기 실행
+#define CONFIG_DEFAULT_LOOP_MODE     joy::LoopMode::Polling
+
 // 3. 초기화 조건 (안전 장치)
 // 프로그램 시작 후 일정 시간(초)이 지나야 하며, 특정 시작 버튼을 눌러야 제어 입력이 들어갑니다.
 #define CONFIG_INIT_DELAY_SEC        2.0f  // 대기 시간 (초)
@@ -32,6 +60,24 @@
 #define CONFIG_FILTER_TAU            0.66f   // Low-pass 필터 시정수(초). 값이 클수록 묵직하고 느리게 반응.
 #define CONFIG_DEFAULT_DEADZONE      0.1f    // 데드존 (이하의 미세한 스틱 움직임 무시)
 
+// 4-1. 응답 곡선 (데드존 이후 적용, setAxisCurve()로 축별 변경 가능)
+// joy::CurveType::Linear / Quadratic / Cubic / Expo / Lut
+#define CONFIG_RESPONSE_CURVE        joy::CurveType::Quadratic
+#define CONFIG_CURVE_EXPO            0.5f    // Expo 곡선의 3차 항 비율 (0 = 선형, 1 = 3차)
+
+// 4-2. 노이즈 필터 종류 (axis_filter.h)
+// joy::FilterType::Ema              : 1차 EMA (CONFIG_FILTER_TAU). 노이즈를 줄이려 시정수를 키우면 반응이 그만큼 늦어짐
+// joy::FilterType::Butterworth      : 2차 Butterworth (CONFIG_FILTER_CUTOFF_HZ). 차단 주파수 위를 40dB/decade로 깎아
+//                                     같은 노이즈 수준에서 EMA보다 위상 지연이 훨씬 작음
+// joy::FilterType::CriticallyDamped : 2차 임계 감쇠. Butterworth보다 조금 느리지만 스텝 입력에 오버슈트가 없음
+// joy::FilterType::OneEuro          : 적응형 1차 필터. 멈춰 있을 때는 CONFIG_FILTER_CUTOFF_HZ로 강하게 거르고
+//                                     스틱 속도에 비례해 차단 주파수를 올려 빠른 조작의 지연을 없앰
+//                                     (최소 0.24Hz = EMA 0.66초, beta 0.3: 잡음은 EMA 0.33초보다 낮고, 90% 도달 390ms)
+#define CONFIG_FILTER_TYPE           joy::FilterType::Ema
+#define CONFIG_FILTER_CUTOFF_HZ      0.5f    // 2차 필터의 차단(극) 주파수, OneEuro의 최소 차단 주파수 (Hz). 0.5Hz Butterworth ≈ EMA 0.66초와 같은 잡음, 90% 도달은 약 45% 빠름
+#define CONFIG_ONE_EURO_BETA         0.3f    // OneEuro: 스틱 속도(최대 폭/초) 1당 올릴 차단 주파수 (Hz). 0이면 고정 EMA와 같음
+#define CONFIG_ONE_EURO_D_CUTOFF_HZ  1.0f    // OneEuro: 속도 추정 필터의 차단 주파수 (Hz)
+
 // 5. 버튼 누적기 (가상 축) 속도 조절
 // L1/R1, L2/R2 버튼을 누르고 있을 때 초당 얼마나 증감할지 결정 (1.0 = 초당 1.0 누적)
 #define CONFIG_ACCUM_RATE            0.5f
@@ -49,11 +95,33 @@
 #define CONFIG_BUTTON_L2             6
 #define CONFIG_BUTTON_R2             7
 
+// 8. 공유 메모리 발행 (shared_state.h)
+// 이름("/joystick0" 형식)을 지정하면 발행하는 JoystickState를 POSIX 공유 메모리에도 써서
+// 다른 프로세스가 SharedStateReader로 장치를 열지 않고 읽을 수 있습니다. 빈 문자열이면 끔.
+#define CONFIG_SHARED_MEMORY_NAME    ""
+
+// 9. 작업 스레드 실시간 설정 (rt_thread.h, joy::RealtimeThread / joy::defaultRealtimeOptions())
+// 다른 프로세스가 CPU를 다 써도 주기를 지키도록 SCHED_FIFO 우선순위, CPU 고정, 메모리 잠금을 적용합니다.
+// 권한(CAP_SYS_NICE / RLIMIT_RTPRIO, RLIMIT_MEMLOCK)이 없으면 적용하지 못한 항목만 보고하고 일반 스레드로 동작합니다.
+#define CONFIG_RT_PRIORITY           0            // SCHED_FIFO 우선순위 1..99 (0 = SCHED_OTHER 유지)
+#define CONFIG_RT_CPU                (-1)         // 고정할 CPU 번호 (-1 = 고정 안 함)
+// mlockall로 메모리를 잠그려면 아래 주석을 해제하세요.
+// #define CONFIG_RT_LOCK_MEMORY
+#define CONFIG_RT_STACK_SIZE         (512 * 1024) // 작업 스레드 스택 크기 (바이트, 0 = 시스템 기본값)
+#define CONFIG_RT_PREFAULT_STACK     (256 * 1024) // 시작 시 미리 건드려 둘 스택 (바이트)
+
+// 10. 고정 주기 파이프라인 (axis_pipeline.h, joy::processAxesFixed)
+// 런타임 설정이 위 1~6번 값(루프 주기, 필터, 데드존, 곡선, 슬루)과 같고 주기를 놓치지 않은 틱에서는
+// alpha, 데드존 범위, 슬루 maxDelta를 빌드 때 상수로 접은 커널로 축을 처리합니다. 매 틱 파라미터를
+// 다시 만들지 않으며 결과는 일반 경로와 비트 단위로 같습니다. 설정이 다르거나 틱을 놓치면 일반 경로를 씁니다.
+// 활성화하려면 아래 주석을 해제하세요.
+// #define CONFIG_FIXED_RATE_PIPELINE
+
 // =========================================================================================
 
 namespace joy { 
 
-extern std::atomic<bool> inputEnabled;    // true여야만 runJoystickThread가 조작을 반영합니다.
+extern std::atomic<bool> inputEnabled;    // true여야만 runJoystickThread가 조작을 반영합니다. (기본 장치용)
 
 // Raw axis value max (abs). negative 방향과 positive 방향이 약간 다르므로 분리.
 constexpr float RAW_AXIS_MAX_NEG        = 32767.0f;  // 음수 측 최대 절대값
@@ -70,30 +138,552 @@ struct JoystickState {
     int buttons[MAX_BUTTONS]; // Button states (0 or 1)
     float lr1_accumulated;  // 누적기 1 (L1/R1)
     float lr2_accumulated;  // 누적기 2 (L2/R2)
+
+    // 발행 정보 (getState/getJoystickState로 받은 스냅샷에서만 의미 있음)
+    uint64_t sequence;      // 내용이 바뀌어 발행될 때마다 1씩 증가 (0: 아직 발행 전)
+    int64_t  eventTimeNs;   // 반영된 가장 최근 입력의 시각 (CLOCK_MONOTONIC ns)
+                            //  evdev: 커널 이벤트 타임스탬프, joydev: js_event.time에서 추정한 시각 (jiffy 해상도)
+    int64_t  publishTimeNs; // 이 스냅샷을 발행한 시각 (CLOCK_MONOTONIC ns)
 };
 
+// 장치마다 보관하는 버튼 edge 수. 소비자가 이보다 많이 밀리면 오래된 edge부터 놓친다.
+constexpr size_t BUTTON_EDGE_CAPACITY = 256;
+using ButtonEdgeQueue = ButtonEdgeRing<BUTTON_EDGE_CAPACITY>;
+
+// 축별 응답 곡선 묶음
+struct AxisCurves {
+    ResponseCurve axes[MAX_AXES];
+};
+
+// 커널 입력 API 선택 (input_backend.h)
+enum class InputBackendType {
+    Auto,     // 경로 이름이 event*이면 Evdev, 아니면 Joydev
+    Joydev,   // /dev/input/js*    (js_event)
+    Evdev,    // /dev/input/event* (input_event, 하드웨어 타임스탬프, SYN_REPORT 프레임)
+    Replay,   // *.joyrec          (InputRecorder로 녹화한 파일 재생)
+};
+
+class InputBackend;
+class InputRecorder;
+class HotplugWatcher;
+class SharedStatePublisher;
+
+// 장치 경로 버퍼 크기 (JoystickConfig::devicePath)
+constexpr int CONFIG_PATH_MAX = 128;
+
+/**
+ * @brief JoystickConfig
+ *
+ * 런타임 설정. 위 User Configuration Area의 CONFIG_* 매크로는 이 구조체의 기본값
+ * (defaultJoystickConfig)으로만 쓰입니다. 설정 파일에서 읽거나(parseJoystickConfigFile)
+ * 스레드 실행 중에 JoystickDevice::setConfig로 교체할 수 있으며, 작업 스레드는
+ * 다음 틱부터 락 없이(seqlock) 새 설정을 사용합니다.
+ */
+struct JoystickConfig {
+    char  devicePath[CONFIG_PATH_MAX];  // 장치 경로 (바꾸면 장치를 다시 연다)
+    char  deviceName[CONFIG_PATH_MAX];  // 장치 이름으로 찾기 (빈 문자열이면 비교 안 함, 바꾸면 다시 연다)
+    int   vendorId;             // USB vendor ID로 찾기 (0이면 비교 안 함)
+    int   productId;            // USB product ID로 찾기 (0이면 비교 안 함)
+    InputBackendType backend;   // 입력 API (바꾸면 장치를 다시 연다)
+    int   loopHz;               // 루프 주파수. 한 매니저의 장치들 중 가장 큰 값을 사용
+    float initDelaySec;         // 초기화 대기 시간 (초)
+    int   buttonStart;          // 시작 트리거 버튼 인덱스
+    int   buttonKill;           // 비상 정지 버튼 인덱스
+    float filterTau;            // Low-pass 필터 시정수 (초, FilterType::Ema)
+    FilterType filterType;      // 노이즈 필터 종류
+    float filterCutoffHz;       // 2차 필터 차단 주파수 / OneEuro 최소 차단 주파수 (Hz)
+    float oneEuroBeta;          // OneEuro 속도 계수 (Hz / (최대 폭/초))
+    float oneEuroDCutoffHz;     // OneEuro 속도 추정 필터 차단 주파수 (Hz)
+    float deadZone;             // 데드존 (0 ~ 1 미만)
+    float accumRate;            // 버튼 누적기 초당 증감량
+    bool  useSlew;              // 슬루율 제한 사용 여부
+    float slewInitialMaxRate;   // 스위치 타임 동안의 초당 최대 변화량
+    float slewRunningMaxRate;   // 이후 초당 최대 변화량
+    float slewSwitchTimeS;      // 스위치 타임 (초)
+    int   buttonL1;
+    int   buttonR1;
+    int   buttonL2;
+    int   buttonR2;
+    AxisCurves curves;          // 축별 응답 곡선
+    char  sharedMemoryName[CONFIG_PATH_MAX];  // 공유 메모리 발행 이름 (빈 문자열이면 끔)
+};
+
+// 장치를 (다시) 열 때마다 입력 백엔드를 만드는 함수. nullptr을 돌려주면 "장치 없음"으로 보고 재연결을 계속 시도
+using InputBackendFactory = std::function<std::unique_ptr<InputBackend>(const JoystickConfig &config)>;
+
+// CONFIG_* 매크로 값으로 채운 기본 설정
+JoystickConfig defaultJoystickConfig(const char *devicePath = CONFIG_JOYSTICK_DEVICE);
+
+// 설정 값 범위 검사. 문제가 있으면 false와 함께 error에 이유를 담습니다.
+bool validateJoystickConfig(const JoystickConfig &config, std::string *error = nullptr);
+
+/**
+ * @brief 설정 파일을 읽어 config 위에 덮어씁니다
+ *
+ * 한 줄에 "key = value" 하나, '#' 뒤는 주석입니다. 파일에 없는 키는 config의 값을 유지합니다.
+ *   device, device_name, vendor_id, product_id (16진수), backend (auto / joydev / evdev / replay), hz, init_delay_sec, button_start, button_kill,
+ *   filter (ema / butterworth / critically_damped / one_euro), filter_tau, filter_cutoff_hz,
+ *   one_euro_beta, one_euro_d_cutoff_hz, deadzone,
+ *   accum_rate, use_slew, slew_initial_max_rate, slew_running_max_rate, slew_switch_time_s,
+ *   button_l1, button_r1, button_l2, button_r2, shared_memory,
+ *   curve, curve_expo                       (모든 축)
+ *   axisN.curve, axisN.expo, axisN.lut      (축 N, lut는 쉼표로 구분한 CURVE_LUT_POINTS개 값)
+ * curve 값: linear / quadratic / cubic / expo / lut
+ *
+ * 파싱이나 검사(validateJoystickConfig)에 실패하면 config를 바꾸지 않고 false를 반환합니다.
+ */
+bool parseJoystickConfigFile(const char *path, JoystickConfig &config, std::string *error = nullptr);
+
+// 축 파이프라인 한 틱 처리에 필요한 파라미터 (makeAxisPipelineParams로 생성)
+struct AxisPipelineParams {
+    float alpha;                  // LPF 계수
+    float deadZoneThreshold;      // 데드존 임계치
+    float maxDelta;               // 슬루율 제한 (한 틱 최대 변화량)
+    bool  useSlew;                // 슬루율 제한 사용 여부
+    bool  applyLowpass;           // false면 LPF 단계를 건너뜀: filtered를 이미 걸러진 값(입력)으로 쓰고 raw는 읽지 않음
+    AxisCurves curves;            // 축별 응답 곡선
+    // processAxesBatch용 곡선 계수: y = x * (c1 + x * (c2 + x * c3))
+    float curveC1[MAX_AXES];
+    float curveC2[MAX_AXES];
+    float curveC3[MAX_AXES];
+    uint32_t lutMask;             // Lut 곡선을 쓰는 축 비트마스크 (스칼라로 보정)
+};
+
+AxisPipelineParams makeAxisPipelineParams(float alpha, float deadZoneThreshold, float maxDelta,
+                                          bool useSlew, const AxisCurves &curves);
+
+// ── 파이프라인 단계 함수 (updateSharedState 내부 단계, 벤치마크/검증용으로 공개) ──
+float lowpassFilter_Joy(float previous, float current, float alpha);
+float normalizeAxisValue(float raw);
+float scaleJoystickOutput(float normalized, float deadZoneThreshold, const ResponseCurve &curve);
+float applySlewRate(float previous, float desired, float maxDelta);
+
+// 전체 축에 필터 → 정규화 → 데드존+곡선 → 슬루를 적용
+//  - raw: 축 raw 값 / filtered: LPF 상태(in/out) / out: 축 출력(in: 직전 출력, out: 새 출력)
+//  - params.applyLowpass가 false면 필터 단계는 호출 측(예: BiquadBank)이 이미 filtered에 해 둔 것으로 봄
+// processAxesScalar는 단계 함수를 축마다 호출하는 기준 구현,
+// processAxesBatch는 같은 결과를 내는 분기 없는 벡터 구현입니다.
+void processAxesScalar(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                       const AxisPipelineParams &params);
+void processAxesBatch(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                      const AxisPipelineParams &params);
+
+// CONFIG_* 값으로 고정한 파이프라인 (axis_pipeline.h의 Pipeline 인스턴스)
+//  - 필터는 CONFIG_FILTER_TYPE이 Ema일 때만 EMA, 그 밖에는 filtered를 이미 걸러진 값으로 봄
+//  - initialSlewPhase: 슬루 스위치 타임 이전인지 (슬루를 쓰지 않으면 무시)
+// 한 틱 dt = FIXED_PIPELINE_DT일 때 makeAxisPipelineParams(CONFIG_* 값) + processAxesScalar와 같은 결과
+extern const float FIXED_PIPELINE_DT;
+void processAxesFixed(const float raw[MAX_AXES], float filtered[MAX_AXES], float out[MAX_AXES],
+                      bool initialSlewPhase);
+
+// config의 루프 주기/필터/데드존/곡선/슬루가 processAxesFixed가 고정한 값과 같은지
+bool matchesFixedPipeline(const JoystickConfig &config);
+
+// runJoystickThread / JoystickManager의 루프 방식
+enum class LoopMode {
+    Polling,      // 절대 데드라인까지 stop eventfd ppoll 대기 (epoll을 쓸 수 없는 환경의 대체 경로)
+    EventDriven,  // epoll + timerfd: 이벤트는 도착 즉시, 필터 틱은 고정 주기
+};
+
+// 다음에 시작할 runJoystickThread / JoystickManager::run의 루프 방식을 설정 (스레드 시작 전에 호출)
+void setLoopMode(LoopMode mode);
+LoopMode getLoopMode();
+
+// 이벤트 처리 통계 (작업 스레드가 매 틱 갱신)
+struct JoystickStats {
+    uint32_t lastTickEvents;  // 직전 틱에서 한꺼번에 반영(coalesce)된 이벤트 수
+    uint32_t maxTickEvents;   // 지금까지 한 틱에 반영된 최대 이벤트 수
+    uint64_t totalEvents;     // 누적 처리 이벤트 수
+    uint64_t ticks;           // 누적 틱 수
+    uint64_t missedTicks;     // 데드라인 overrun으로 건너뛴 틱 수
+    int64_t  lastInputLatencyNs;  // 입력 시각 → 발행까지 걸린 시간 (evdev: 커널 타임스탬프, joydev: js_event.time 추정, jiffy 해상도)
+    int64_t  maxInputLatencyNs;   // 지금까지의 최대 입력 지연
+    uint64_t droppedRecords;      // 녹화 버퍼가 가득 차 버려진 레코드 수
+};
+
+// 지연 분포 (JoystickDevice::getLatency). 장치가 살아 있는 동안 항상 기록됩니다.
+// input은 루프 대기(폴링 주기)까지 포함한 전체 지연이고, process는 그중 작업 스레드가 큐를 읽은 뒤의 몫입니다.
+// joydev의 입력 시각은 js_event.time(jiffies ms)에서 추정하므로 input의 해상도는 커널 tick(1~10ms)입니다.
+struct JoystickLatency {
+    LatencySnapshot input;    // 입력 시각(JoystickState::eventTimeNs와 같은 기준) → 그 입력을 반영한 틱의 발행
+    LatencySnapshot process;  // 작업 스레드가 큐에서 이벤트를 읽은 시각 → 그 틱의 발행 (대기 시간 제외)
+    LatencySnapshot read;     // 발행 → 소비자가 그 상태를 처음 읽음 (getState / waitForUpdate)
+};
+
+// updateSharedState가 틱 사이에 유지하는 장치별 필터 상태
+struct AxisFilterState {
+    bool  firstCall;                  // true면 다음 호출에서 현재 raw 값으로 필터를 채움
+    float filteredRaw[MAX_AXES];      // 필터 출력 (raw 단위, 필터 종류와 상관없이 여기에 남음)
+    float slewElapsedS;               // 첫 updateSharedState 이후 누적한 dt (슬루율 초기/안정 구간 판단)
+    FilterType activeFilter;          // 직전 틱에 쓴 필터 종류 (다른 필터로 바뀌면 새 필터를 filteredRaw로 채움)
+    BiquadBank<MAX_AXES> biquad;      // FilterType::Butterworth / CriticallyDamped 상태와 계수
+    OneEuroBank<MAX_AXES> oneEuro;    // FilterType::OneEuro 상태
+    bool  fixedPipeline;              // 설정이 matchesFixedPipeline을 만족 (설정이 바뀔 때 갱신, CONFIG_FIXED_RATE_PIPELINE)
+    bool  paramsValid;                // false면 다음 호출에서 params를 설정으로 다시 만듦 (설정이 바뀔 때 false로)
+    AxisPipelineParams params;        // 설정에서 만든 커널 파라미터 사본. 틱마다 alpha/maxDelta만 갱신
+};
+
+// 필터 상태 초기화 (재연결/Kill Switch 시 직전 방향값 잔상 제거)
+void resetFilterState(AxisFilterState &filter);
+
+// raw 축 값을 필터·정규화·곡선·슬루 처리해 head.axes에, 버튼을 head.buttons에 반영
+void updateSharedState(JoystickState &head, AxisFilterState &filter, const JoystickState &localState,
+                       float dt, const JoystickConfig &config);
+
+// L1/R1, L2/R2 버튼 상태에 따라 head의 누적기를 갱신
+void updateAccumulators(JoystickState &head, const JoystickState &state, float dt, const JoystickConfig &config);
+
+
+/**
+ * @brief JoystickDevice
+ *
+ * 조이스틱 장치 하나. 장치 경로, 필터 상태, 초기화 게이팅, 발행 상태(seqlock)를 모두
+ * 자기 안에 가지므로 여러 장치(예: 조종자 패드 + 안전 감시자 패드)를 한 프로세스에서 쓸 수 있습니다.
+ *
+ *  - 소비자 API(getState, getStats, setAxisCurve 등)는 어느 스레드에서든 호출할 수 있습니다.
+ *  - 작업 스레드 API(open, readPendingEvents, tick 등)는 JoystickManager의 스레드에서만 호출합니다.
+ */
+class JoystickDevice {
+public:
+    /**
+     * @param devicePath   장치 경로 (예: "/dev/input/js0"). 나머지 설정은 CONFIG_* 기본값
+     * @param enabledFlag  입력 허용 플래그를 외부 변수로 둘 때 지정 (nullptr이면 장치 내부 플래그 사용)
+     * @param clock        초기화 대기/재연결/발행 시각에 쓸 시계 (nullptr이면 systemClock(), 장치보다 오래 살아 있어야 함)
+     */
+    explicit JoystickDevice(const char *devicePath, std::atomic<bool> *enabledFlag = nullptr);
+    explicit JoystickDevice(const JoystickConfig &config, std::atomic<bool> *enabledFlag = nullptr,
+                            const Clock *clock = nullptr);
+    ~JoystickDevice();
+
+    JoystickDevice(const JoystickDevice &) = delete;
+    JoystickDevice &operator=(const JoystickDevice &) = delete;
+
+    // ── 소비자 API (스레드 안전, 락 없음) ──
+    std::string devicePath() const;
+    JoystickState getState() const;          // 최신 발행 상태
+
+    /**
+     * @brief 새 상태가 발행될 때까지 대기
+     *
+     * 발행된 상태의 sequence가 lastSequence와 달라지면 그 상태를 state에 담아 true를 반환합니다.
+     * 이미 다르면 바로 반환합니다. 대기는 futex로 하므로 기다리는 동안 CPU를 쓰지 않습니다.
+     *
+     * @param lastSequence  직전에 처리한 state.sequence (처음에는 0)
+     * @param state         새 상태 (출력. 시간 초과면 마지막 상태)
+     * @param timeoutMs     최대 대기 시간 (ms). -1이면 무한 대기, 0이면 확인만
+     * @return 새 상태를 받았으면 true, 시간 초과면 false
+     */
+    bool waitForUpdate(uint64_t lastSequence, JoystickState &state, int timeoutMs = -1) const;
+
+    /**
+     * @brief 자체 epoll/poll 루프용 알림 fd (eventfd)
+     *
+     * 새 상태가 발행되면 readable이 됩니다. 깨어나면 8바이트를 read해 카운터를 비우고
+     * getState()로 상태를 가져옵니다. 처음 호출한 뒤부터 발행마다 신호가 갑니다.
+     * fd는 장치가 소멸할 때 닫히므로 호출 측에서 close하지 않습니다.
+     */
+    int updateFd();
+
+    /**
+     * @brief 버튼 edge(눌림/뗌) 읽기
+     *
+     * buttons[]는 현재 값만 담으므로 두 번의 getState() 사이(또는 한 틱 안)에 눌렀다 뗀
+     * 짧은 탭은 보이지 않습니다. 작업 스레드는 버튼 값이 바뀔 때마다 시각과 함께 edge를
+     * 락 없는 링 버퍼에 넣고, 소비자는 각자 cursor로 자기 속도대로 읽습니다.
+     * 읽기가 BUTTON_EDGE_CAPACITY개 넘게 밀리면 오래된 것부터 버려지고 cursor.dropped가 늘어납니다.
+     */
+    ButtonEdgeCursor buttonEdgeCursor() const;   // 지금 이후의 edge부터 읽는 cursor
+    size_t readButtonEdges(ButtonEdgeCursor &cursor, ButtonEdge *out, size_t maxEdges) const;
+
+    /**
+     * @brief 입력 녹화 (recorder.h)
+     *
+     * 백엔드가 읽은 모든 입력(시각 포함)과 발행된 모든 JoystickState를 path에 녹화합니다.
+     * 파일 쓰기는 별도 스레드가 하므로 작업 스레드의 틱 시간에 영향이 없습니다.
+     * 녹화 파일은 장치 경로로 지정해(backend = replay 또는 *.joyrec) 그대로 재생할 수 있습니다.
+     */
+    bool startRecording(const char *path, std::string *error = nullptr);
+    void stopRecording();
+    bool isRecording() const;
+
+    JoystickStats getStats() const;          // 이벤트 처리 통계
+
+    /**
+     * @brief 지연 히스토그램 (latency_histogram.h)
+     *
+     * p50/p90/p99/p99.9/max를 ns로 돌려줍니다. 기록 비용은 틱당(입력) 또는 발행당(읽기)
+     * atomic 몇 번이라 항상 켜 둡니다. 주기적으로 읽어 지연 예산을 넘는지 감시하고,
+     * 구간별로 보고 싶으면 읽은 뒤 resetLatency()를 호출합니다.
+     */
+    JoystickLatency getLatency() const;
+    void resetLatency();
+    bool isInputEnabled() const;             // 초기화 게이팅을 통과했는지
+    bool isConnected() const;
+    void setAxisCurve(int axis, const ResponseCurve &curve);  // 다음 틱부터 반영
+    ResponseCurve getAxisCurve(int axis) const;
+
+    // ── 런타임 설정 (스레드 실행 중에도 호출 가능, 다음 틱부터 반영) ──
+    JoystickConfig getConfig() const;
+    bool setConfig(const JoystickConfig &config, std::string *error = nullptr);  // 검사 실패 시 false
+    bool loadConfig(const char *path, std::string *error = nullptr);            // 현재 설정 위에 파일 적용
+
+    // ── 작업 스레드 API ──
+    bool open();                             // 논블록킹으로 열기. 실패하면 false
+    bool open(std::unique_ptr<InputBackend> backend);  // 직접 만든 백엔드로 열기 (시뮬레이터 등)
+    // open/재연결 시 makeInputBackend 대신 쓸 factory (가짜 장치 등). run 시작 전에 호출
+    void setBackendFactory(InputBackendFactory factory);
+    void close();
+    int fd() const;
+    bool readPendingEvents();                // 큐를 모두 비움. 끊어졌으면 false
+    void handleKillSwitch();                 // Kill Switch가 눌렸으면 출력/필터 초기화
+    void handleDisconnect();                 // 장치를 닫고 출력/필터 초기화
+    void resetToDisconnected();              // handleDisconnect와 같은 초기화 (로그/재연결 지연 없음)
+    bool tryReconnect();                     // 1초 간격으로 재연결 시도. 성공하면 true
+    void requestReconnect();                 // 다음 tryReconnect는 간격을 기다리지 않고 바로 시도 (핫플러그)
+    // 끊어진 상태에서 dir에 생긴 노드 name이 이 장치일 수 있으면 requestReconnect (name == nullptr: 모름)
+    void noteHotplugNode(const std::string &dir, const char *name);
+    void tick(float dt);                     // 게이팅 + 필터 + 누적기 한 틱 실행 후 발행
+    void recordMissedTicks(uint64_t missed);
+    int loopHz() const;                      // 작업 스레드가 보고 있는 설정의 루프 주파수
+
+private:
+    void refreshConfig();                    // 설정이 바뀌었으면 작업용 사본(cfg_)을 갱신
+    const char *resolveDevicePath();         // 식별 정보와 맞는 노드 경로 (못 찾으면 nullptr)
+    void applySharedStateConfig();           // cfg_.sharedMemoryName에 맞춰 공유 메모리 발행을 열거나 닫음
+    bool openBackend(std::unique_ptr<InputBackend> backend, const char *path);
+    void resetOutputs();                     // 누적기를 제외한 출력과 필터 상태를 0으로
+    void clearLocalState();                  // raw 상태를 0으로 (눌려 있던 버튼은 뗌 edge 기록)
+    void publishState();
+    void noteRead(const JoystickState &state) const;  // 새 발행 상태를 처음 읽었으면 읽기 지연 기록
+
+    std::unique_ptr<InputBackend> backend_;  // 열려 있는 동안의 입력 백엔드
+    InputBackendFactory backendFactory_;     // 비어 있으면 makeInputBackend 사용
+    std::atomic<bool> connected_;
+    std::atomic<bool> ownInputEnabled_;
+    std::atomic<bool> *inputEnabled_;
+
+    // 작업 스레드 전용 상태
+    JoystickState localState_;               // raw 축/버튼 값
+    JoystickState head_;                     // 작업용 출력 상태 (publishState로 발행)
+    AxisFilterState filter_;
+    JoystickConfig cfg_;                     // 작업 스레드가 쓰는 설정 사본
+    uint32_t cfgSequence_;                   // cfg_를 읽어 온 시점의 config_ 시퀀스
+    const Clock *clock_;
+    int64_t startTimeNs_;                    // 초기화 게이팅 기준 시각
+    int64_t nextReconnectNs_;                // 다음 재연결 시도 시각
+    int64_t nextWaitLogNs_;                  // 다음 "재연결 대기" 로그를 찍을 수 있는 시각 (시도마다 찍지 않음)
+    std::string matchedPath_;                // 식별 정보로 마지막에 찾은 노드 (캐시, 비어 있으면 없음)
+    bool initDone_;
+    uint32_t pendingEvents_;                 // 직전 틱 이후 반영된 이벤트 수
+    int64_t pendingEventTimeNs_;             // 직전 틱 이후 반영된 마지막 이벤트의 커널 타임스탬프 (0: 없음)
+    int64_t pendingReadTimeNs_;              // 직전 틱 이후 마지막으로 이벤트를 읽은 시각 (0: 없음)
+    int64_t lastEventTimeNs_;                // 지금까지 반영된 가장 최근 입력 시각 (JoystickState::eventTimeNs)
+    JoystickState lastPublished_;            // 직전에 발행한 상태 (변경 여부 비교용)
+    bool killPressed_;                       // 직전 틱 이후 Kill Switch 눌림 이벤트 여부
+
+    // 스레드 간 공유 상태
+    SeqLock<JoystickState> published_;
+    mutable std::atomic<uint32_t> updateWord_;      // 발행마다 증가하는 futex 워드
+    mutable std::atomic<uint32_t> updateWaiters_;   // waitForUpdate에서 잠든 소비자 수
+    int updateEventFd_;
+    std::atomic<bool> updateEventFdUsed_;           // updateFd()가 불린 뒤에만 eventfd에 신호
+    ButtonEdgeQueue buttonEdges_;
+    std::unique_ptr<InputRecorder> recorder_;
+    std::unique_ptr<SharedStatePublisher> sharedState_;  // 작업 스레드 전용 (cfg_.sharedMemoryName)
+    SeqLock<JoystickConfig> config_;
+    std::mutex configWriteMutex_;            // setConfig/setAxisCurve 호출자 간 직렬화 (작업 스레드는 잡지 않음)
+    std::atomic<uint32_t> lastTickEvents_;
+    std::atomic<uint32_t> maxTickEvents_;
+    std::atomic<uint64_t> totalEvents_;
+    std::atomic<uint64_t> ticks_;
+    std::atomic<uint64_t> missedTicks_;
+    std::atomic<int64_t> lastInputLatencyNs_;
+    std::atomic<int64_t> maxInputLatencyNs_;
+    LatencyHistogram inputLatency_;
+    LatencyHistogram processLatency_;
+    mutable LatencyHistogram readLatency_;
+    mutable std::atomic<uint64_t> lastReadSequence_;  // 읽기 지연을 이미 기록한 가장 최근 sequence
+};
+
+
+/**
+ * @brief JoystickManager
+ *
+ * 여러 JoystickDevice를 스레드 하나로 관리합니다.
+ * LoopMode::EventDriven에서는 모든 장치 fd와 timerfd를 epoll 하나로 대기하고,
+ * LoopMode::Polling에서는 매 주기 모든 장치를 차례로 읽습니다.
+ * 끊어진 장치는 다른 장치의 틱을 막지 않고 재연결을 시도합니다. 장치 경로의 디렉터리(/dev/input 등)를
+ * inotify로 감시하므로 노드가 다시 생기면 바로 열고, 그 밖에는 1초 간격으로 시도합니다.
+ */
+class JoystickManager {
+public:
+    JoystickManager();
+    ~JoystickManager();
+    JoystickManager(const JoystickManager &) = delete;
+    JoystickManager &operator=(const JoystickManager &) = delete;
+
+    // 장치 추가 (run 시작 전에 호출)
+    JoystickDevice &addDevice(const char *devicePath, std::atomic<bool> *enabledFlag = nullptr);
+    JoystickDevice &addDevice(const JoystickConfig &config, std::atomic<bool> *enabledFlag = nullptr);
+    size_t deviceCount() const;
+    JoystickDevice &device(size_t index);
+
+    /**
+     * @brief 모든 장치를 열고 requestStop()이 불릴 때까지 루프를 실행
+     *
+     * 처음 열리지 않은 장치는 끊어진 장치와 똑같이 재연결을 시도합니다.
+     * 루프를 빠져나오면 모든 장치를 close합니다. 보통 JoystickService로 실행합니다.
+     */
+    void run();
+
+    /**
+     * @brief 예전 방식: continueRunning이 false가 되거나 requestStop()이 불릴 때까지 실행
+     *
+     * 플래그는 다음 틱(또는 이벤트)에 깨어났을 때만 확인하므로 종료가 최대 한 주기 늦습니다.
+     * 바로 멈춰야 하면 requestStop()을 쓰세요.
+     */
+    void run(std::atomic<bool> &continueRunning);
+
+    // 일반 bool 플래그 버전. 다른 스레드가 일반 bool에 쓰는 것 자체가 data race(정의되지 않은 동작)이므로
+    // 읽는 쪽만 고쳐서는 안전해지지 않습니다. std::atomic<bool> 버전이나 JoystickService를 쓰세요.
+    [[deprecated("plain bool stop flag is a data race; use std::atomic<bool>& or JoystickService")]]
+    void run(bool &continueRunning);
+
+    /**
+     * @brief 실행 중인 run()을 멈춤 (어느 스레드에서나, 시그널 핸들러에서도 호출 가능)
+     *
+     * stop eventfd에 신호를 보내므로 루프가 clock 대기나 epoll_wait 중이어도 바로 깨어나 종료합니다.
+     * 요청은 clearStopRequest()를 부를 때까지 유지되어, run() 시작 전에 불려도 놓치지 않습니다.
+     */
+    void requestStop();
+    void clearStopRequest();                 // 다시 run()하기 전에 호출 (run 실행 중에는 부르지 말 것)
+    bool stopRequested() const { return stopRequested_.load(); }
+
+private:
+    friend void runJoystickThread(bool &continueJoystickThread);   // 사용 중단된 bool 버전이 runLoops를 직접 부름
+
+    // legacyFlag: 사용 중단된 bool& 진입점의 플래그 (실행 동안 legacyFlag_에 둠)
+    void runLoops(const std::atomic<bool> *continueRunning, const bool *legacyFlag = nullptr);
+    bool keepRunning(const std::atomic<bool> *continueRunning) const;
+    bool runEventLoop(const std::atomic<bool> *continueRunning, HotplugWatcher &hotplug);
+    void runPollingLoop(const std::atomic<bool> *continueRunning, HotplugWatcher &hotplug);
+    void waitUntil(const struct timespec &deadline);
+    void reconnectDevices(int epfd);
+    void handleHotplug(int epfd, HotplugWatcher &hotplug);  // 알림을 비우고 해당 장치만 바로 재연결 시도
+    long long desiredLoopNs();               // 장치 설정 중 가장 큰 loopHz의 주기
+
+    std::vector<std::unique_ptr<JoystickDevice>> devices_;
+    std::atomic<bool> stopRequested_;
+    int stopFd_;                             // requestStop()이 쓰는 eventfd (루프 대기를 깨움)
+    const bool *legacyFlag_;                 // 사용 중단된 bool& 진입점으로 실행 중일 때만 (아니면 nullptr)
+};
+
+/**
+ * @brief JoystickService
+ *
+ * JoystickManager를 RealtimeThread(rt_thread.h)에서 실행하고 멈추는 수명 관리 객체.
+ * stop()은 JoystickManager::requestStop()으로 루프 대기를 바로 깨운 뒤 스레드를 join하므로
+ * 루프 주기나 재연결 간격과 상관없이 곧바로 돌아오며, 같은 객체로 다시 start()할 수 있습니다.
+ * start / stop은 한 스레드(제어 스레드)에서 부르세요.
+ *
+ *   joy::JoystickService service;        // 기본 장치(CONFIG_JOYSTICK_DEVICE) 매니저
+ *   service.start();
+ *   ...
+ *   service.stop();
+ */
+class JoystickService {
+public:
+    JoystickService();                               // defaultJoystickManager() 실행
+    explicit JoystickService(JoystickManager &manager);
+    ~JoystickService();                              // 실행 중이면 stop()
+
+    JoystickService(const JoystickService &) = delete;
+    JoystickService &operator=(const JoystickService &) = delete;
+
+    // 이미 실행 중이거나 스레드를 만들지 못하면 false
+    bool start(const RealtimeOptions &options = defaultRealtimeOptions(), std::string *error = nullptr);
+    void stop();
+    bool isRunning() const { return thread_.joinable(); }
+
+    JoystickManager &manager() { return manager_; }
+    const RealtimeReport &threadReport() const { return thread_.report(); }
+
+private:
+    JoystickManager &manager_;
+    RealtimeThread thread_;
+};
+
+
+// ── 기본 장치(CONFIG_JOYSTICK_DEVICE) API ──
+// runJoystickThread / JoystickService()가 실행하는 기본 JoystickManager의 장치에 대한 함수들입니다.
+
+// 기본 매니저 (장치 CONFIG_JOYSTICK_DEVICE 하나). 프로세스가 끝날 때까지 해제되지 않습니다.
+JoystickManager &defaultJoystickManager();
+
 // 스레드 안전하게 최신 조이스틱 상태를 가져오는 함수 (외부에서 호출)
+// seqlock으로 발행된 값을 락 없이 복사하므로, 여러 스레드가 동시에 불러도
+// 서로 또는 runJoystickThread를 블록하지 않습니다.
 JoystickState getJoystickState();
 
+// 이벤트 처리 통계를 가져오는 함수 (외부에서 호출, 락 없음)
+JoystickStats getJoystickStats();
+
+// 기본 장치의 지연 히스토그램 (JoystickDevice::getLatency 참고)
+JoystickLatency getJoystickLatency();
+void resetJoystickLatency();
+
+// 기본 장치의 새 상태를 기다림 (JoystickDevice::waitForUpdate 참고)
+bool waitForJoystickUpdate(uint64_t lastSequence, JoystickState &state, int timeoutMs = -1);
+int getJoystickUpdateFd();
+
+// 기본 장치의 입력 녹화 (JoystickDevice::startRecording 참고)
+bool startJoystickRecording(const char *path, std::string *error = nullptr);
+void stopJoystickRecording();
+
+// 기본 장치의 버튼 edge 읽기 (JoystickDevice::readButtonEdges 참고)
+ButtonEdgeCursor makeButtonEdgeCursor();
+size_t readButtonEdges(ButtonEdgeCursor &cursor, ButtonEdge *out, size_t maxEdges);
+
+// 축 하나의 응답 곡선을 변경 (스레드 실행 중에도 호출 가능, 다음 틱부터 반영)
+void setAxisCurve(int axis, const ResponseCurve &curve);
+ResponseCurve getAxisCurve(int axis);
+
+// 기본 장치의 런타임 설정 조회/교체 (스레드 실행 중에도 호출 가능, 다음 틱부터 반영)
+JoystickConfig getJoystickConfig();
+bool setJoystickConfig(const JoystickConfig &config, std::string *error = nullptr);
+bool reloadJoystickConfig(const char *path, std::string *error = nullptr);
 
 /**
  * @brief 조이스틱 이벤트를 지속적으로 읽고 처리하는 함수
  *
  * 이 함수는 별도의 스레드에서 실행되며, 아래 과정을 반복합니다:
  * 1. JOYSTICK_DEVICE 경로의 조이스틱 디바이스를 논블록킹 모드로 open
- * 2. js_event 구조체로부터 축(axis) 및 버튼 이벤트를 읽어 localState에 저장
+ * 2. 매 틱마다 큐에 쌓인 js_event를 EAGAIN이 날 때까지 모두 읽어 localState에 저장
  *    - 축 이벤트: raw 값을 localState.axes[index]에 대입
  *    - 버튼 이벤트: state 값을 localState.buttons[index]에 대입
  * 3. BUTTON_L1/R1, BUTTON_L2/R2 버튼 상태에 따라 lr1_accumulated, lr2_accumulated를
  *    ACCUM_STEP 만큼 감소/증가시켜 누적값을 갱신
  * 4. updateSharedState() 호출을 통해
- *    low-pass 필터 → 정규화 → 데드존+스케일링 → 슬루율 제한 순으로
+ *    low-pass 필터 → 정규화 → 데드존+응답 곡선 → 슬루율 제한 순으로
  *    최종 축 값을 내부 상태에 안전하게 갱신
- * 5. 루프 주파수(CONFIG_JOYSTICK_HZ)를 맞춰 usleep으로 대기
- * 6. 외부에서 continueJoystickThread를 false로 설정하면 루프를 빠져나가고 디바이스를 close
+ * 5. 루프 주파수(CONFIG_JOYSTICK_HZ)를 맞춰 대기
+ *    - LoopMode::Polling     : 다음 절대 데드라인까지 남은 시간을 매번 다시 계산해 stop eventfd를 ppoll
+ *                              (eventfd를 만들지 못했으면 clock_nanosleep(TIMER_ABSTIME))
+ *    - LoopMode::EventDriven : epoll_wait로 이벤트/timerfd 대기 (이벤트는 도착 즉시 반영)
+ * 6. 외부에서 continueJoystickThread를 false로 설정하면 루프를 빠져나가고 디바이스를 닫아 끊긴 상태로 초기화 (출력 0, 입력 비활성)
+ *
+ * 내부적으로 CONFIG_JOYSTICK_DEVICE 장치 하나를 가진 JoystickManager를 실행합니다.
+ * 장치를 처음 열지 못하면 바로 반환합니다.
+ * 플래그는 다음 틱에 확인하므로 종료가 최대 한 주기 늦습니다. 바로 멈추고 다시 시작해야 하면
+ * JoystickService를 쓰세요.
  *
  * @param continueJoystickThread  true인 동안 루프 실행, false로 변경 시 루프 종료
  */
+void runJoystickThread(std::atomic<bool> &continueJoystickThread);
+
+// 일반 bool 플래그 버전. 다른 스레드가 쓰는 일반 bool은 data race이므로 std::atomic<bool> 버전이나
+// JoystickService를 쓰세요.
+[[deprecated("plain bool stop flag is a data race; use std::atomic<bool>& or JoystickService")]]
 void runJoystickThread(bool &continueJoystickThread);
 
 }  // namespace joy
@@ -0,0 +1,128 @@
+#ifndef JOYSTICK_LATENCY_HISTOGRAM_H
+#define JOYSTICK_LATENCY_HISTOGRAM_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace joy {
+
+// LatencyHistogram::snapshot() 결과. 모든 값은 ns, 기록이 없으면 0
+struct LatencySnapshot {
+    uint64_t count;
+    int64_t  mean;
+    int64_t  p50;
+    int64_t  p90;
+    int64_t  p99;
+    int64_t  p999;
+    int64_t  max;
+};
+
+/**
+ * @brief LatencyHistogram
+ *
+ * HDR 방식(로그-선형)의 지연 히스토그램. 2의 거듭제곱 구간마다 SUB_BUCKETS개의 선형 칸을 두어
+ * 0 ~ 약 36분(2^41 ns) 범위를 상대 오차 1/SUB_BUCKETS(약 3%) 안에서 고정 크기 배열로 기록합니다.
+ *
+ *  - record()는 칸 하나에 relaxed fetch_add만 하므로 어느 스레드에서든 락 없이 부를 수 있습니다.
+ *  - snapshot()은 기록과 동시에 불러도 되며, 그 사이에 들어온 기록은 다음 스냅샷에 반영될 수 있습니다.
+ *  - 백분위 값은 해당 칸의 상한(같은 칸에 들어가는 가장 큰 값)으로 보고합니다. max는 정확한 값입니다.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int    SUB_BITS    = 5;
+    static constexpr int    SUB_BUCKETS = 1 << SUB_BITS;                     // 구간당 칸 수
+    static constexpr int    MAX_SHIFT   = 35;                                // 2^(MAX_SHIFT + 6) ns 이상은 마지막 칸
+    static constexpr size_t BUCKETS     = (MAX_SHIFT + 2) * SUB_BUCKETS;
+
+    LatencyHistogram() { reset(); }
+
+    LatencyHistogram(const LatencyHistogram &) = delete;
+    LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+    void record(int64_t ns) {
+        if (ns < 0) {
+            ns = 0;
+        }
+        counts_[bucketOf(static_cast<uint64_t>(ns))].fetch_add(1, std::memory_order_relaxed);
+        total_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+        int64_t prev = max_.load(std::memory_order_relaxed);
+        while (ns > prev && !max_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            counts_[i].store(0, std::memory_order_relaxed);
+        }
+        total_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+    }
+
+    LatencySnapshot snapshot() const {
+        uint64_t counts[BUCKETS];
+        uint64_t total = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            counts[i] = counts_[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+
+        LatencySnapshot snap = {};
+        snap.count = total;
+        if (total == 0) {
+            return snap;
+        }
+        uint64_t recorded = total_.load(std::memory_order_relaxed);
+        snap.mean = static_cast<int64_t>(sum_.load(std::memory_order_relaxed) / (recorded ? recorded : 1));
+        snap.max  = max_.load(std::memory_order_relaxed);
+
+        // 누적 개수가 total * q 이상이 되는 첫 칸
+        const double quantiles[4] = {0.50, 0.90, 0.99, 0.999};
+        int64_t *outputs[4] = {&snap.p50, &snap.p90, &snap.p99, &snap.p999};
+        uint64_t seen = 0;
+        size_t q = 0;
+        for (size_t i = 0; i < BUCKETS && q < 4; ++i) {
+            seen += counts[i];
+            while (q < 4 && static_cast<double>(seen) >= quantiles[q] * static_cast<double>(total)) {
+                *outputs[q] = static_cast<int64_t>(bucketUpperBound(i));
+                if (*outputs[q] > snap.max) {
+                    *outputs[q] = snap.max;  // 칸 상한이 실제 최대보다 크게 보고되지 않도록
+                }
+                ++q;
+            }
+        }
+        return snap;
+    }
+
+private:
+    // 값 < 2 * SUB_BUCKETS는 1ns 단위 그대로, 그 위로는 구간마다 SUB_BUCKETS칸
+    static size_t bucketOf(uint64_t v) {
+        if (v < 2 * SUB_BUCKETS) {
+            return static_cast<size_t>(v);
+        }
+        int shift = (63 - __builtin_clzll(v)) - SUB_BITS;   // v >> shift 는 [SUB_BUCKETS, 2 * SUB_BUCKETS)
+        if (shift > MAX_SHIFT) {
+            return BUCKETS - 1;
+        }
+        return static_cast<size_t>(shift * SUB_BUCKETS) + static_cast<size_t>(v >> shift);
+    }
+
+    static uint64_t bucketUpperBound(size_t index) {
+        if (index < 2 * SUB_BUCKETS) {
+            return index;
+        }
+        int shift = static_cast<int>(index / SUB_BUCKETS) - 1;
+        uint64_t sub = index % SUB_BUCKETS + SUB_BUCKETS;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::atomic<uint64_t> counts_[BUCKETS];
+    std::atomic<uint64_t> total_;
+    std::atomic<uint64_t> sum_;
+    std::atomic<int64_t>  max_;
+};
+
+}  // namespace joy
+#endif // JOYSTICK_LATENCY_HISTOGRAM_H
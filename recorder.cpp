@@ -0,0 +1,201 @@
+#include "recorder.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <time.h>
+
+namespace joy {
+
+// 레코드 하나의 최대 payload 크기 (가장 큰 것은 Config)
+static constexpr uint32_t MAX_RECORD_PAYLOAD = sizeof(JoystickConfig) > sizeof(JoystickState)
+                                                   ? sizeof(JoystickConfig) : sizeof(JoystickState);
+
+// 녹화 스레드가 링을 비우는 주기
+static constexpr long WRITER_PERIOD_NS = 10000000L;  // 10 ms
+
+static int64_t monotonicNowNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+
+InputRecorder::InputRecorder()
+    : fd_(-1),
+      writer_(),
+      active_(false),
+      writerRunning_(false),
+      producersInFlight_(0),
+      dropped_(0),
+      head_(0),
+      tail_(0),
+      ring_(nullptr) {
+}
+
+InputRecorder::~InputRecorder() {
+    stop();
+    delete[] ring_;
+}
+
+/**
+ * @brief start
+ *
+ * 파일을 새로 만들어(기존 파일은 덮어씀) 헤더와 현재 설정을 쓰고 녹화 스레드를 시작합니다.
+ * 이미 녹화 중이면 먼저 멈춥니다.
+ */
+bool InputRecorder::start(const char *path, const JoystickConfig &config, std::string *error) {
+    stop();
+
+    if (ring_ == nullptr) {
+        ring_ = new unsigned char[RING_SIZE];  // 녹화를 한 번도 하지 않는 장치는 링을 만들지 않음
+    }
+    fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        if (error) {
+            *error = std::string("cannot create ") + path + ": " + std::strerror(errno);
+        }
+        return false;
+    }
+
+    RecordFileHeader header = {};
+    std::memcpy(header.magic, RECORD_MAGIC, sizeof(header.magic));
+    header.version    = RECORD_VERSION;
+    header.headerSize = sizeof(RecordFileHeader);
+    header.maxAxes    = MAX_AXES;
+    header.maxButtons = MAX_BUTTONS;
+    header.stateSize  = sizeof(JoystickState);
+    header.configSize = sizeof(JoystickConfig);
+    if (write(fd_, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+        if (error) {
+            *error = std::string("cannot write ") + path + ": " + std::strerror(errno);
+        }
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    // 작업 스레드가 아직 보지 않으므로(active_ == false) 링을 비워도 안전
+    head_.store(0);
+    tail_.store(0);
+    dropped_.store(0);
+    record(RecordType::Config, monotonicNowNs(), &config, sizeof(config));  // active_ 전이라 직접 기록
+
+    writerRunning_.store(true);
+    writer_ = std::thread(&InputRecorder::writerLoop, this);
+    active_.store(true);
+    return true;
+}
+
+/**
+ * @brief stop
+ *
+ * 작업 스레드가 새 레코드를 넣지 못하게 한 뒤, 이미 record() 안에 들어와 있던 호출이
+ * 끝나기를 기다리고 남은 레코드를 모두 파일로 내보냅니다.
+ */
+void InputRecorder::stop() {
+    active_.store(false);
+    while (producersInFlight_.load() != 0) {
+        std::this_thread::yield();
+    }
+    if (writer_.joinable()) {
+        writerRunning_.store(false);
+        writer_.join();
+    }
+    if (fd_ >= 0) {
+        flush();
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool InputRecorder::isRecording() const {
+    return active_.load();
+}
+
+uint64_t InputRecorder::droppedRecords() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+void InputRecorder::recordInput(int64_t timeNs, RecordInputKind kind, int index, float value) {
+    RecordInput input;
+    input.kind  = static_cast<uint16_t>(kind);
+    input.index = static_cast<uint16_t>(index);
+    input.value = value;
+    record(RecordType::Input, timeNs, &input, sizeof(input));
+}
+
+void InputRecorder::recordSync(int64_t timeNs) {
+    record(RecordType::Sync, timeNs, nullptr, 0);
+}
+
+void InputRecorder::recordState(const JoystickState &state) {
+    record(RecordType::State, state.publishTimeNs, &state, sizeof(state));
+}
+
+void InputRecorder::record(RecordType type, int64_t timeNs, const void *payload, uint32_t size) {
+    if (type != RecordType::Config && !active_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    producersInFlight_.fetch_add(1);
+    if (type == RecordType::Config || active_.load()) {
+        unsigned char buffer[sizeof(RecordHeader) + MAX_RECORD_PAYLOAD];
+        RecordHeader header;
+        header.type   = static_cast<uint32_t>(type);
+        header.size   = size;
+        header.timeNs = timeNs;
+        std::memcpy(buffer, &header, sizeof(header));
+        if (size > 0) {
+            std::memcpy(buffer + sizeof(header), payload, size);
+        }
+        if (!push(buffer, sizeof(header) + size)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    producersInFlight_.fetch_sub(1);
+}
+
+// 레코드 하나를 통째로 링에 넣습니다. 자리가 없으면 일부만 넣지 않고 false.
+bool InputRecorder::push(const void *data, uint64_t size) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    if (RING_SIZE - (head - tail) < size) {
+        return false;
+    }
+    uint64_t offset = head & (RING_SIZE - 1);
+    uint64_t first = std::min<uint64_t>(size, RING_SIZE - offset);
+    std::memcpy(ring_ + offset, data, first);
+    std::memcpy(ring_, static_cast<const unsigned char *>(data) + first, size - first);
+    head_.store(head + size, std::memory_order_release);
+    return true;
+}
+
+// 링에 쌓인 바이트를 파일로 내보냄 (녹화 스레드 또는 stop에서만 호출)
+void InputRecorder::flush() {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    uint64_t head = head_.load(std::memory_order_acquire);
+    while (tail != head) {
+        uint64_t offset = tail & (RING_SIZE - 1);
+        uint64_t chunk = std::min<uint64_t>(head - tail, RING_SIZE - offset);
+        ssize_t written = write(fd_, ring_ + offset, chunk);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;  // 디스크 에러: 남은 데이터는 버리지 않고 다음 주기에 다시 시도
+        }
+        tail += static_cast<uint64_t>(written);
+        tail_.store(tail, std::memory_order_release);
+    }
+}
+
+void InputRecorder::writerLoop() {
+    struct timespec period = {0, WRITER_PERIOD_NS};
+    while (writerRunning_.load()) {
+        flush();
+        nanosleep(&period, nullptr);
+    }
+}
+
+}  // namespace joy
@@ -0,0 +1,108 @@
+#ifndef JOYSTICK_RECORDER_H
+#define JOYSTICK_RECORDER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "joystick.h"
+
+namespace joy {
+
+/*
+   녹화 파일 형식 (*.joyrec, 리틀 엔디언, 추가 전용)
+
+   RecordFileHeader
+   { RecordHeader + payload(size 바이트) } 반복
+
+   - Config: 녹화 시작 시의 JoystickConfig (재생 시 같은 설정을 쓰기 위한 참고용)
+   - Input : 백엔드가 읽은 입력 하나. 축 값은 ±32767 canonical 범위, 버튼은 0/1
+   - Sync  : 여기까지의 Input을 localState에 한꺼번에 반영 (evdev SYN_REPORT / joydev read 배치)
+   - State : 발행된 JoystickState (재생 결과와 비교하는 용도)
+*/
+constexpr char     RECORD_MAGIC[8] = {'J', 'O', 'Y', 'R', 'E', 'C', '\0', '\0'};
+constexpr uint32_t RECORD_VERSION  = 1;
+
+enum class RecordType : uint32_t {
+    Config = 1,
+    Input  = 2,
+    Sync   = 3,
+    State  = 4,
+};
+
+enum class RecordInputKind : uint16_t {
+    Axis   = 1,
+    Button = 2,
+};
+
+struct RecordFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t headerSize;    // sizeof(RecordFileHeader)
+    uint32_t maxAxes;
+    uint32_t maxButtons;
+    uint32_t stateSize;     // sizeof(JoystickState)
+    uint32_t configSize;    // sizeof(JoystickConfig)
+};
+
+struct RecordHeader {
+    uint32_t type;          // RecordType
+    uint32_t size;          // 뒤따르는 payload 바이트 수
+    int64_t  timeNs;        // CLOCK_MONOTONIC ns
+};
+
+struct RecordInput {
+    uint16_t kind;          // RecordInputKind
+    uint16_t index;         // 축/버튼 인덱스
+    float    value;
+};
+
+/**
+ * @brief InputRecorder
+ *
+ * 작업 스레드가 읽은 입력과 발행한 상태를 파일에 녹화합니다.
+ * 작업 스레드(record*)는 락 없는 SPSC 바이트 링에 레코드를 복사만 하고,
+ * 실제 write()는 녹화 전용 스레드가 주기적으로 모아서 합니다. 링이 가득 차면
+ * 작업 스레드를 막지 않고 레코드를 버린 뒤 droppedRecords()로 알려 줍니다.
+ */
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder &) = delete;
+    InputRecorder &operator=(const InputRecorder &) = delete;
+
+    // ── 제어 API (작업 스레드가 아닌 곳에서 호출) ──
+    bool start(const char *path, const JoystickConfig &config, std::string *error = nullptr);
+    void stop();                              // 남은 레코드를 모두 쓰고 파일을 닫음
+    bool isRecording() const;
+    uint64_t droppedRecords() const;
+
+    // ── 작업 스레드 API (녹화 중이 아니면 아무것도 하지 않음) ──
+    void recordInput(int64_t timeNs, RecordInputKind kind, int index, float value);
+    void recordSync(int64_t timeNs);
+    void recordState(const JoystickState &state);
+
+private:
+    static constexpr uint64_t RING_SIZE = 1u << 20;  // 1 MiB (2의 거듭제곱)
+
+    void record(RecordType type, int64_t timeNs, const void *payload, uint32_t size);
+    bool push(const void *data, uint64_t size);
+    void writerLoop();
+    void flush();
+
+    int fd_;
+    std::thread writer_;
+    std::atomic<bool> active_;                // 작업 스레드가 레코드를 넣어도 되는지
+    std::atomic<bool> writerRunning_;
+    std::atomic<uint32_t> producersInFlight_; // record() 안에 있는 작업 스레드 수 (stop 동기화용)
+    std::atomic<uint64_t> dropped_;
+    alignas(64) std::atomic<uint64_t> head_;  // 작업 스레드가 쓴 바이트 수
+    alignas(64) std::atomic<uint64_t> tail_;  // 녹화 스레드가 파일로 내보낸 바이트 수
+    unsigned char *ring_;
+};
+
+}  // namespace joy
+#endif // JOYSTICK_RECORDER_H
@@ -0,0 +1,127 @@
+#ifndef JOYSTICK_RESPONSE_CURVE_H
+#define JOYSTICK_RESPONSE_CURVE_H
+
+#include <cmath>
+
+namespace joy {
+
+// 데드존 이후 [0, 1] 크기에 적용할 응답 곡선 종류
+enum class CurveType {
+    Linear,     // y = x
+    Quadratic,  // y = x^2            (기존 기본 곡선)
+    Cubic,      // y = x^3
+    Expo,       // y = (1 - e) * x + e * x^3   (e = ResponseCurve::expo, 0 ~ 1)
+    Lut,        // [0, 1]을 균등 분할한 점들 사이를 선형 보간
+};
+
+// Lut 곡선의 점 개수 (x = i / (CURVE_LUT_POINTS - 1) 위치의 y 값)
+constexpr int CURVE_LUT_POINTS = 9;
+
+// 축 하나의 응답 곡선 설정
+struct ResponseCurve {
+    CurveType type;
+    float expo;                     // Expo 곡선의 3차 항 비율 (0 = 선형, 1 = 3차)
+    float lut[CURVE_LUT_POINTS];    // Lut 곡선의 y 값 (0 ~ 1, 단조 증가 권장)
+};
+
+/**
+ * @brief applyDeadzone
+ *
+ * 응답 곡선의 첫 단계. 절대값이 deadZoneThreshold 미만이면 0,
+ * 이상이면 [deadZoneThreshold, 1] 구간을 [0, 1]로 선형 매핑합니다.
+ *
+ * @param absVal            입력 절대값 (0 ~ 1)
+ * @param deadZoneThreshold 데드존 임계치 (0.0 ~ 1.0)
+ */
+inline float applyDeadzone(float absVal, float deadZoneThreshold) {
+    if (absVal < deadZoneThreshold) {
+        return 0.0f;
+    }
+    return (absVal - deadZoneThreshold) / (1.0f - deadZoneThreshold);
+}
+
+// Lut 곡선: 인접한 두 점 사이를 선형 보간
+inline float evalCurveLut(const float (&lut)[CURVE_LUT_POINTS], float x) {
+    float pos = x * (CURVE_LUT_POINTS - 1);
+    int i = static_cast<int>(pos);
+    if (i >= CURVE_LUT_POINTS - 1) {
+        return lut[CURVE_LUT_POINTS - 1];
+    }
+    float t = pos - static_cast<float>(i);
+    return lut[i] + t * (lut[i + 1] - lut[i]);
+}
+
+/**
+ * @brief evalCurve (컴파일 타임 선택)
+ *
+ * 곡선 종류가 템플릿 인자로 고정되므로 분기 없이 곱셈 몇 번으로 인라인됩니다.
+ *
+ * @param x      데드존 처리 후의 크기 (0 ~ 1)
+ * @param curve  Expo/Lut 파라미터 (다른 곡선에서는 사용하지 않음)
+ */
+template <CurveType C>
+inline float evalCurve(float x, const ResponseCurve &curve) {
+    if constexpr (C == CurveType::Linear) {
+        (void)curve;
+        return x;
+    } else if constexpr (C == CurveType::Quadratic) {
+        (void)curve;
+        return x * x;
+    } else if constexpr (C == CurveType::Cubic) {
+        (void)curve;
+        return x * x * x;
+    } else if constexpr (C == CurveType::Expo) {
+        return x * ((1.0f - curve.expo) + curve.expo * x * x);
+    } else {
+        return evalCurveLut(curve.lut, x);
+    }
+}
+
+// evalCurve (런타임 선택): 축마다 곡선이 다를 때 사용
+inline float evalCurve(float x, const ResponseCurve &curve) {
+    switch (curve.type) {
+        case CurveType::Linear:    return evalCurve<CurveType::Linear>(x, curve);
+        case CurveType::Quadratic: return evalCurve<CurveType::Quadratic>(x, curve);
+        case CurveType::Cubic:     return evalCurve<CurveType::Cubic>(x, curve);
+        case CurveType::Expo:      return evalCurve<CurveType::Expo>(x, curve);
+        case CurveType::Lut:       return evalCurve<CurveType::Lut>(x, curve);
+    }
+    return x;
+}
+
+/**
+ * @brief shapeAxis
+ *
+ * 정규화된 축 값(-1 ~ 1)에 데드존 → 응답 곡선을 적용하고 부호를 되돌립니다.
+ *
+ * @tparam C                곡선 종류 (컴파일 타임)
+ * @param normalized        -1.0 ~ 1.0으로 정규화된 입력 값
+ * @param deadZoneThreshold 데드존 임계치 (0.0 ~ 1.0)
+ * @param curve             Expo/Lut 파라미터
+ * @return 가공된 출력 값 (-1.0 ~ 1.0)
+ */
+template <CurveType C>
+inline float shapeAxis(float normalized, float deadZoneThreshold, const ResponseCurve &curve) {
+    float magnitude = evalCurve<C>(applyDeadzone(std::fabs(normalized), deadZoneThreshold), curve);
+    return (normalized >= 0) ? magnitude : -magnitude;
+}
+
+// shapeAxis (런타임 선택)
+inline float shapeAxis(float normalized, float deadZoneThreshold, const ResponseCurve &curve) {
+    float magnitude = evalCurve(applyDeadzone(std::fabs(normalized), deadZoneThreshold), curve);
+    return (normalized >= 0) ? magnitude : -magnitude;
+}
+
+// 곡선 종류만 지정한 ResponseCurve (Lut은 y = x로 채움)
+inline ResponseCurve makeResponseCurve(CurveType type, float expo = 0.0f) {
+    ResponseCurve curve;
+    curve.type = type;
+    curve.expo = expo;
+    for (int i = 0; i < CURVE_LUT_POINTS; ++i) {
+        curve.lut[i] = static_cast<float>(i) / (CURVE_LUT_POINTS - 1);
+    }
+    return curve;
+}
+
+}  // namespace joy
+#endif // JOYSTICK_RESPONSE_CURVE_H
@@ -0,0 +1,191 @@
+#include "rt_thread.h"
+#include "joystick.h"
+
+#include <alloca.h>
+#include <limits.h>
+#include <sched.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+
+namespace joy {
+
+RealtimeOptions defaultRealtimeOptions() {
+    RealtimeOptions options;
+    options.priority      = CONFIG_RT_PRIORITY;
+    options.cpu           = CONFIG_RT_CPU;
+#ifdef CONFIG_RT_LOCK_MEMORY
+    options.lockMemory    = true;
+#else
+    options.lockMemory    = false;
+#endif
+    options.stackSize     = CONFIG_RT_STACK_SIZE;
+    options.prefaultStack = CONFIG_RT_PREFAULT_STACK;
+    return options;
+}
+
+static const char *policyName(int policy) {
+    switch (policy) {
+        case SCHED_OTHER: return "SCHED_OTHER";
+        case SCHED_FIFO:  return "SCHED_FIFO";
+        case SCHED_RR:    return "SCHED_RR";
+#ifdef SCHED_BATCH
+        case SCHED_BATCH: return "SCHED_BATCH";
+#endif
+#ifdef SCHED_IDLE
+        case SCHED_IDLE:  return "SCHED_IDLE";
+#endif
+        default:          return "SCHED_?";
+    }
+}
+
+std::string formatRealtimeReport(const RealtimeReport &report) {
+    std::string text = std::string(policyName(report.policy)) + "/" + std::to_string(report.priority);
+    text += report.cpu >= 0 ? " cpu " + std::to_string(report.cpu) : " cpu any";
+    text += report.memoryLocked ? " mlock" : " no-mlock";
+    text += " stack " + std::to_string(report.stackSize / 1024) + " KiB";
+    text += " (prefaulted " + std::to_string(report.prefaultedBytes / 1024) + " KiB)";
+    if (!report.errors.empty()) {
+        text += " [" + report.errors + "]";
+    }
+    return text;
+}
+
+static void appendError(std::string &errors, const std::string &what, int error) {
+    if (!errors.empty()) {
+        errors += "; ";
+    }
+    errors += what + ": " + std::strerror(error);
+}
+
+RealtimeThread::RealtimeThread() : thread_(), running_(false), options_(), report_(), ready_(false) {
+    pthread_mutex_init(&readyMutex_, nullptr);
+    pthread_cond_init(&readyCond_, nullptr);
+}
+
+RealtimeThread::~RealtimeThread() {
+    join();
+    pthread_cond_destroy(&readyCond_);
+    pthread_mutex_destroy(&readyMutex_);
+}
+
+bool RealtimeThread::start(std::function<void()> body, const RealtimeOptions &options, std::string *error) {
+    if (running_) {
+        if (error) {
+            *error = "thread already running";
+        }
+        return false;
+    }
+    body_    = std::move(body);
+    options_ = options;
+    report_  = RealtimeReport{};
+    ready_   = false;
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    if (options_.stackSize > 0) {
+        size_t stackSize = std::max<size_t>(options_.stackSize, PTHREAD_STACK_MIN);
+        pthread_attr_setstacksize(&attr, stackSize);
+    }
+    int result = pthread_create(&thread_, &attr, &RealtimeThread::entry, this);
+    pthread_attr_destroy(&attr);
+    if (result != 0) {
+        if (error) {
+            *error = std::string("pthread_create: ") + std::strerror(result);
+        }
+        return false;
+    }
+    running_ = true;
+
+    // 새 스레드가 설정을 모두 적용하고 report_를 채울 때까지 대기
+    pthread_mutex_lock(&readyMutex_);
+    while (!ready_) {
+        pthread_cond_wait(&readyCond_, &readyMutex_);
+    }
+    pthread_mutex_unlock(&readyMutex_);
+    return true;
+}
+
+void RealtimeThread::join() {
+    if (running_) {
+        pthread_join(thread_, nullptr);
+        running_ = false;
+    }
+}
+
+void *RealtimeThread::entry(void *self) {
+    RealtimeThread *thread = static_cast<RealtimeThread *>(self);
+    thread->applyOptions();
+
+    pthread_mutex_lock(&thread->readyMutex_);
+    thread->ready_ = true;
+    pthread_cond_signal(&thread->readyCond_);
+    pthread_mutex_unlock(&thread->readyMutex_);
+
+    thread->body_();
+    return nullptr;
+}
+
+// 새 스레드 안에서 호출: 우선순위 → CPU 고정 → 메모리 잠금 → 스택 prefault
+void RealtimeThread::applyOptions() {
+    RealtimeReport report = {};
+    report.cpu = -1;
+    pthread_t self = pthread_self();
+
+    if (options_.priority > 0) {
+        struct sched_param param = {};
+        param.sched_priority = options_.priority;
+        int result = pthread_setschedparam(self, SCHED_FIFO, &param);
+        if (result != 0) {
+            appendError(report.errors, "SCHED_FIFO/" + std::to_string(options_.priority), result);
+        }
+    }
+
+    if (options_.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(options_.cpu, &set);
+        int result = pthread_setaffinity_np(self, sizeof(set), &set);
+        if (result == 0) {
+            report.cpu = options_.cpu;
+        } else {
+            appendError(report.errors, "cpu " + std::to_string(options_.cpu), result);
+        }
+    }
+
+    if (options_.lockMemory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+            report.memoryLocked = true;
+        } else {
+            appendError(report.errors, "mlockall", errno);
+        }
+    }
+
+    // 실제로 얻은 스택 크기와 정책을 다시 읽어 보고
+    pthread_attr_t attr;
+    if (pthread_getattr_np(self, &attr) == 0) {
+        pthread_attr_getstacksize(&attr, &report.stackSize);
+        pthread_attr_destroy(&attr);
+    }
+    struct sched_param param = {};
+    pthread_getschedparam(self, &report.policy, &param);
+    report.priority = param.sched_priority;
+
+    // 스택 끝(가드 페이지)까지 가지 않도록 64 KiB를 남긴다. 건드린 페이지는 mlockall(MCL_FUTURE)로 잠긴다
+    size_t prefault = options_.prefaultStack;
+    const size_t margin = 64 * 1024;
+    if (report.stackSize > 0 && prefault + margin > report.stackSize) {
+        prefault = report.stackSize > margin ? report.stackSize - margin : 0;
+    }
+    if (prefault > 0) {
+        volatile char *stack = static_cast<volatile char *>(alloca(prefault));
+        for (size_t i = 0; i < prefault; i += 4096) {
+            stack[i] = 0;
+        }
+        report.prefaultedBytes = prefault;
+    }
+    report_ = report;
+}
+
+}  // namespace joy
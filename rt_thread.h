@@ -0,0 +1,78 @@
+#ifndef JOYSTICK_RT_THREAD_H
+#define JOYSTICK_RT_THREAD_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <pthread.h>
+
+namespace joy {
+
+// 작업 스레드 실시간 설정 (defaultRealtimeOptions()는 joystick.h의 CONFIG_RT_* 값)
+struct RealtimeOptions {
+    int    priority;       // SCHED_FIFO 우선순위 1..99 (0이면 SCHED_OTHER 그대로)
+    int    cpu;            // 스레드를 고정할 CPU 번호 (-1이면 고정하지 않음)
+    bool   lockMemory;     // mlockall(MCL_CURRENT | MCL_FUTURE)로 프로세스 메모리를 잠금
+    size_t stackSize;      // 스레드 스택 크기 (0이면 시스템 기본값)
+    size_t prefaultStack;  // 시작할 때 미리 건드려 둘 스택 바이트 (틱 도중 페이지 폴트 방지)
+};
+
+// 스레드가 시작하면서 실제로 얻은 설정. 권한 부족 등으로 못 얻은 항목은 errors에 남습니다.
+struct RealtimeReport {
+    int    policy;          // SCHED_OTHER / SCHED_FIFO ...
+    int    priority;
+    int    cpu;             // 고정된 CPU (-1: 고정 안 됨)
+    bool   memoryLocked;
+    size_t stackSize;       // 실제 스레드 스택 크기
+    size_t prefaultedBytes;
+    std::string errors;     // 요청했지만 적용하지 못한 항목 ("; "로 구분, 비어 있으면 모두 성공)
+};
+
+RealtimeOptions defaultRealtimeOptions();
+
+// "SCHED_FIFO/80 cpu 2 mlock stack 512 KiB (prefaulted 256 KiB)" 형태의 한 줄 요약
+std::string formatRealtimeReport(const RealtimeReport &report);
+
+/**
+ * @brief RealtimeThread
+ *
+ * 실시간 설정을 적용한 스레드를 만들어 body를 실행합니다. std::thread로는 스택 크기를 정할 수
+ * 없으므로 pthread로 직접 만들고, 새 스레드 안에서 우선순위 → CPU 고정 → 메모리 잠금 → 스택
+ * prefault 순으로 적용한 뒤 body를 부릅니다. start()는 적용이 끝날 때까지 기다렸다가 돌아오므로
+ * 곧바로 report()로 결과를 확인할 수 있습니다.
+ *
+ * 우선순위나 메모리 잠금에 필요한 권한(CAP_SYS_NICE, RLIMIT_RTPRIO, RLIMIT_MEMLOCK)이 없어도
+ * 스레드는 시작합니다. 얻지 못한 설정은 report().errors에 남고 일반 스레드로 동작합니다.
+ */
+class RealtimeThread {
+public:
+    RealtimeThread();
+    ~RealtimeThread();   // 아직 돌고 있으면 join
+
+    RealtimeThread(const RealtimeThread &) = delete;
+    RealtimeThread &operator=(const RealtimeThread &) = delete;
+
+    // 스레드를 만들지 못했거나 이미 실행 중이면 false
+    bool start(std::function<void()> body, const RealtimeOptions &options = defaultRealtimeOptions(),
+               std::string *error = nullptr);
+    void join();
+    bool joinable() const { return running_; }
+
+    const RealtimeReport &report() const { return report_; }
+
+private:
+    static void *entry(void *self);
+    void applyOptions();
+
+    pthread_t thread_;
+    bool running_;
+    std::function<void()> body_;
+    RealtimeOptions options_;
+    RealtimeReport report_;
+    pthread_mutex_t readyMutex_;
+    pthread_cond_t readyCond_;
+    bool ready_;
+};
+
+}  // namespace joy
+#endif // JOYSTICK_RT_THREAD_H
@@ -0,0 +1,92 @@
+#ifndef JOYSTICK_SEQLOCK_H
+#define JOYSTICK_SEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace joy {
+
+/**
+ * @brief SeqLock
+ *
+ * 단일 writer / 다중 reader용 시퀀스 락.
+ *
+ *  - writer(store)는 절대 블록되지 않으며, 시퀀스를 홀수로 올린 뒤 데이터를 쓰고
+ *    다시 짝수로 올려 발행을 마칩니다.
+ *  - reader(load)는 락을 잡지 않고 데이터를 복사한 뒤, 복사 전후 시퀀스가 같고 짝수일 때만
+ *    결과를 사용합니다. 쓰기 도중이었다면 다시 복사합니다.
+ *    reader끼리는 서로 아무 영향도 주지 않고, writer를 기다리게 하지도 않습니다.
+ *
+ * 데이터는 32비트 atomic 워드 배열로 보관하므로 찢어진 복사본을 읽는 순간에도
+ * C++ 메모리 모델상 data race가 없습니다. 같은 이유로 프로세스 간 공유 메모리에 두어도 동작합니다.
+ *
+ * @tparam T  trivially copyable이고 크기가 4바이트 배수인 타입
+ */
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock<T> requires a trivially copyable T");
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "SeqLock<T> requires sizeof(T) to be a multiple of 4");
+
+public:
+    static constexpr size_t WORDS = sizeof(T) / sizeof(uint32_t);
+
+    SeqLock() : seq_(0) {
+        for (size_t i = 0; i < WORDS; ++i) {
+            data_[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    explicit SeqLock(const T &initial) : SeqLock() {
+        store(initial);
+    }
+
+    SeqLock(const SeqLock &) = delete;
+    SeqLock &operator=(const SeqLock &) = delete;
+
+    // 새 값을 발행합니다. writer는 하나만 있어야 합니다.
+    void store(const T &value) {
+        uint32_t words[WORDS];
+        std::memcpy(words, &value, sizeof(T));
+
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < WORDS; ++i) {
+            data_[i].store(words[i], std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // 가장 최근에 발행된 값을 복사해 옵니다. 락을 잡지 않습니다.
+    T load() const {
+        uint32_t words[WORDS];
+        uint32_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; ++i) {
+                words[i] = data_[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1u) || before != after);
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    // 발행 횟수 * 2 (쓰기 중이면 홀수)
+    uint32_t sequence() const {
+        return seq_.load(std::memory_order_acquire);
+    }
+
+private:
+    alignas(64) std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> data_[WORDS];
+};
+
+}  // namespace joy
+#endif // JOYSTICK_SEQLOCK_H
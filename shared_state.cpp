@@ -0,0 +1,186 @@
+#include "shared_state.h"
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <time.h>
+
+namespace joy {
+
+// 프로세스 간 futex이므로 _PRIVATE가 아닌 연산을 쓴다
+static long sharedFutexWait(std::atomic<uint32_t> *word, uint32_t expected, const struct timespec *timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+static void sharedFutexWakeAll(std::atomic<uint32_t> *word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+static bool sharedStateError(std::string *error, const std::string &message) {
+    if (error) {
+        *error = message;
+    }
+    return false;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SharedStatePublisher
+// ─────────────────────────────────────────────────────────────────────────────
+
+SharedStatePublisher::SharedStatePublisher() : segment_(nullptr) {
+}
+
+SharedStatePublisher::~SharedStatePublisher() {
+    close();
+}
+
+bool SharedStatePublisher::open(const char *name, std::string *error) {
+    close();
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return sharedStateError(error, std::string("cannot open shared memory ") + name + ": " + std::strerror(errno));
+    }
+    if (ftruncate(fd, sizeof(SharedStateSegment)) != 0) {
+        int saved = errno;
+        ::close(fd);
+        return sharedStateError(error, std::string("cannot size shared memory ") + name + ": " + std::strerror(saved));
+    }
+    void *memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return sharedStateError(error, std::string("cannot map shared memory ") + name + ": " + std::strerror(errno));
+    }
+
+    // 이전 writer가 만든 같은 형식의 세그먼트는 그대로 이어 쓴다 (붙어 있는 reader가 계속 동작하도록).
+    // 새로 만든 세그먼트(ftruncate로 0)나 형식이 다른 세그먼트만 초기화한다.
+    SharedStateSegment *segment = static_cast<SharedStateSegment *>(memory);
+    if (segment->magic.load(std::memory_order_acquire) != SHARED_STATE_MAGIC ||
+        segment->version != SHARED_STATE_VERSION || segment->stateSize != sizeof(JoystickState)) {
+        new (memory) SharedStateSegment();
+        segment->version   = SHARED_STATE_VERSION;
+        segment->stateSize = sizeof(JoystickState);
+        segment->magic.store(SHARED_STATE_MAGIC, std::memory_order_release);
+    }
+    segment->writerPid.store(static_cast<int32_t>(getpid()), std::memory_order_relaxed);
+    segment_ = segment;
+    return true;
+}
+
+void SharedStatePublisher::close() {
+    if (segment_ != nullptr) {
+        munmap(segment_, sizeof(SharedStateSegment));
+        segment_ = nullptr;
+    }
+}
+
+void SharedStatePublisher::publishToSegment(const JoystickState &state) {
+    segment_->state.store(state);
+    segment_->updateWord.fetch_add(1);
+    if (segment_->waiters.load() > 0) {
+        sharedFutexWakeAll(&segment_->updateWord);
+    }
+}
+
+bool SharedStatePublisher::unlink(const char *name) {
+    return shm_unlink(name) == 0;
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+// SharedStateReader
+// ─────────────────────────────────────────────────────────────────────────────
+
+SharedStateReader::SharedStateReader() : segment_(nullptr) {
+}
+
+SharedStateReader::~SharedStateReader() {
+    close();
+}
+
+bool SharedStateReader::open(const char *name, std::string *error) {
+    close();
+
+    int fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);  // futex 대기 인원(waiters)을 쓰므로 읽기/쓰기로 연다
+    if (fd < 0) {
+        return sharedStateError(error, std::string("cannot open shared memory ") + name + ": " + std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SharedStateSegment))) {
+        ::close(fd);
+        return sharedStateError(error, std::string(name) + ": not a joystick state segment");
+    }
+    void *memory = mmap(nullptr, sizeof(SharedStateSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return sharedStateError(error, std::string("cannot map shared memory ") + name + ": " + std::strerror(errno));
+    }
+
+    SharedStateSegment *segment = static_cast<SharedStateSegment *>(memory);
+    if (segment->magic.load(std::memory_order_acquire) != SHARED_STATE_MAGIC ||
+        segment->version != SHARED_STATE_VERSION || segment->stateSize != sizeof(JoystickState)) {
+        munmap(memory, sizeof(SharedStateSegment));
+        return sharedStateError(error, std::string(name) + ": incompatible segment (version or JoystickState size)");
+    }
+    segment_ = segment;
+    return true;
+}
+
+void SharedStateReader::close() {
+    if (segment_ != nullptr) {
+        munmap(segment_, sizeof(SharedStateSegment));
+        segment_ = nullptr;
+    }
+}
+
+JoystickState SharedStateReader::load() const {
+    if (segment_ == nullptr) {
+        return JoystickState{};
+    }
+    return segment_->state.load();
+}
+
+bool SharedStateReader::waitForUpdate(uint64_t lastSequence, JoystickState &state, int timeoutMs) const {
+    if (segment_ == nullptr) {
+        return false;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs < 0 ? 0 : timeoutMs);
+    while (true) {
+        uint32_t word = segment_->updateWord.load();
+        state = segment_->state.load();
+        if (state.sequence != lastSequence) {
+            return true;
+        }
+
+        struct timespec remaining = {};
+        if (timeoutMs >= 0) {
+            auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) {
+                return false;
+            }
+            remaining.tv_sec  = static_cast<time_t>(left / 1000000000LL);
+            remaining.tv_nsec = static_cast<long>(left % 1000000000LL);
+        }
+        segment_->waiters.fetch_add(1);
+        sharedFutexWait(&segment_->updateWord, word, timeoutMs >= 0 ? &remaining : nullptr);
+        segment_->waiters.fetch_sub(1);
+    }
+}
+
+bool SharedStateReader::isWriterAlive() const {
+    if (segment_ == nullptr) {
+        return false;
+    }
+    pid_t pid = static_cast<pid_t>(segment_->writerPid.load(std::memory_order_relaxed));
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+}  // namespace joy
@@ -0,0 +1,120 @@
+#ifndef JOYSTICK_SHARED_STATE_H
+#define JOYSTICK_SHARED_STATE_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "joystick.h"
+#include "seqlock.h"
+
+namespace joy {
+
+/*
+   공유 메모리 세그먼트 형식 (POSIX shm, 예: /dev/shm/joystick0)
+
+   SharedStateSegment
+   - 헤더(magic, version, stateSize)는 writer가 세그먼트를 처음 만들 때 한 번 쓰고,
+     magic을 마지막에 release로 써서 reader가 초기화가 끝난 세그먼트만 보게 합니다.
+   - state는 SeqLock<JoystickState>이므로 reader는 락 없이, writer를 막지 않고 복사합니다.
+   - updateWord는 발행마다 1씩 늘어나는 futex 워드입니다. reader가 waitForUpdate로 잠들어 있을
+     때만(waiters > 0) writer가 FUTEX_WAKE를 부르므로, 기다리는 reader가 없으면 발행 비용은
+     atomic 연산 몇 번입니다. (reader가 잠든 채로 죽으면 waiters가 남아 writer가 매 발행마다 wake를
+     부르게 되지만 동작에는 문제가 없습니다.)
+   writer가 다시 시작해도 같은 세그먼트를 그대로 이어 쓰므로 reader는 다시 열 필요가 없습니다.
+*/
+constexpr uint32_t SHARED_STATE_MAGIC   = 0x534a4f59;  // "YOJS"
+constexpr uint32_t SHARED_STATE_VERSION = 1;
+
+struct SharedStateSegment {
+    std::atomic<uint32_t> magic;
+    uint32_t version;
+    uint32_t stateSize;                 // sizeof(JoystickState)
+    std::atomic<int32_t>  writerPid;    // 마지막으로 연 writer 프로세스
+    alignas(64) std::atomic<uint32_t> updateWord;
+    std::atomic<uint32_t> waiters;      // waitForUpdate에서 잠든 reader 수 (모든 프로세스 합계)
+    SeqLock<JoystickState> state;
+};
+
+/**
+ * @brief SharedStatePublisher
+ *
+ * JoystickDevice가 발행하는 JoystickState를 공유 메모리 세그먼트에도 발행합니다.
+ * 설정의 shared_memory(JoystickConfig::sharedMemoryName)로 켜며, 작업 스레드에서만 사용합니다.
+ * 세그먼트는 close해도 지우지 않습니다 (reader가 writer 재시작을 그대로 넘기도록). 지우려면 unlink()를 부릅니다.
+ */
+class SharedStatePublisher {
+public:
+    SharedStatePublisher();
+    ~SharedStatePublisher();
+
+    SharedStatePublisher(const SharedStatePublisher &) = delete;
+    SharedStatePublisher &operator=(const SharedStatePublisher &) = delete;
+
+    // name은 shm_open 이름 ("/joystick0" 형식). 이미 열려 있으면 먼저 닫음
+    bool open(const char *name, std::string *error = nullptr);
+    void close();
+    bool isOpen() const { return segment_ != nullptr; }
+
+    // 열려 있지 않으면 아무것도 하지 않음
+    void publish(const JoystickState &state) {
+        if (segment_ != nullptr) {
+            publishToSegment(state);
+        }
+    }
+
+    static bool unlink(const char *name);
+
+private:
+    void publishToSegment(const JoystickState &state);
+
+    SharedStateSegment *segment_;
+};
+
+/**
+ * @brief SharedStateReader
+ *
+ * 다른 프로세스에서 공유 메모리로 발행된 JoystickState를 읽는 클라이언트.
+ * shared_state.cpp 하나만 같이 빌드하면 되고, 장치를 열지 않으므로 여러 프로세스가
+ * 동시에 읽어도 서로 또는 writer와 입력을 다투지 않습니다.
+ *
+ *   joy::SharedStateReader reader;
+ *   reader.open("/joystick0");
+ *   joy::JoystickState state = {};
+ *   while (reader.waitForUpdate(state.sequence, state, 100)) { ... }
+ *
+ * load / waitForUpdate는 한 reader 객체를 여러 스레드에서 불러도 됩니다.
+ */
+class SharedStateReader {
+public:
+    SharedStateReader();
+    ~SharedStateReader();
+
+    SharedStateReader(const SharedStateReader &) = delete;
+    SharedStateReader &operator=(const SharedStateReader &) = delete;
+
+    // 세그먼트가 없거나 형식(version, JoystickState 크기)이 다르면 false
+    bool open(const char *name, std::string *error = nullptr);
+    void close();
+    bool isOpen() const { return segment_ != nullptr; }
+
+    JoystickState load() const;          // 최신 발행 상태 (락 없음). 열려 있지 않으면 0 상태
+
+    /**
+     * @brief 새 상태가 발행될 때까지 대기 (JoystickDevice::waitForUpdate와 같은 규칙)
+     *
+     * @param lastSequence  직전에 처리한 state.sequence (처음에는 0)
+     * @param state         새 상태 (출력. 시간 초과면 마지막 상태)
+     * @param timeoutMs     최대 대기 시간 (ms). -1이면 무한 대기, 0이면 확인만
+     * @return 새 상태를 받았으면 true, 시간 초과거나 열려 있지 않으면 false
+     */
+    bool waitForUpdate(uint64_t lastSequence, JoystickState &state, int timeoutMs = -1) const;
+
+    bool isWriterAlive() const;          // 마지막 writer 프로세스가 아직 살아 있는지
+
+private:
+    SharedStateSegment *segment_;
+};
+
+}  // namespace joy
+#endif // JOYSTICK_SHARED_STATE_H
@@ -0,0 +1,191 @@
+#include "simulator.h"
+#include "input_backend.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace joy {
+
+// 시뮬레이션 시계의 시작 시각. 0은 "타임스탬프 없음"을 뜻하므로 피한다.
+static constexpr int64_t SIM_START_NS = 1000000000LL;
+
+/**
+ * @brief ScriptBackend
+ *
+ * SimScript의 입력 중 시뮬레이션 시계로 시각이 된 것을 drain마다 localState에 반영합니다.
+ * 커널 장치가 없으므로 fd()는 -1이며, JoystickSimulator가 직접 readPendingEvents를 호출합니다.
+ */
+class ScriptBackend : public InputBackend {
+public:
+    ScriptBackend(SimScript &script, const Clock &clock, int64_t startNs)
+        : script_(script), clock_(clock), startNs_(startNs) {}
+
+    const char *name() const override { return "sim"; }
+    bool open(const char *) override { return true; }
+    void close() override {}
+    int fd() const override { return -1; }
+
+    bool drain(JoystickState &localState, int killButton, ButtonEdgeQueue *edges,
+               InputDrainResult &result) override {
+        result = {};
+        int64_t now = clock_.nowNs();
+        while (script_.next < script_.inputs.size()) {
+            const SimInput &input = script_.inputs[script_.next];
+            int64_t timeNs = startNs_ + input.timeNs;
+            if (timeNs > now) {
+                break;
+            }
+            if (input.kind == RecordInputKind::Axis && input.index < MAX_AXES) {
+                localState.axes[input.index] = input.value;
+            } else if (input.kind == RecordInputKind::Button && input.index < MAX_BUTTONS) {
+                int value = input.value != 0.0f ? 1 : 0;
+                int &level = localState.buttons[input.index];
+                if (level != value && edges) {
+                    edges->push(ButtonEdge{timeNs, input.index, static_cast<uint32_t>(value)});
+                }
+                level = value;
+                if (input.index == killButton && value) {
+                    result.killPressed = true;
+                }
+            }
+            if (recorder_) {
+                recorder_->recordInput(timeNs, input.kind, input.index, input.value);
+            }
+            ++result.events;
+            result.eventTimeNs = timeNs;
+            ++script_.next;
+        }
+        if (recorder_ && result.events > 0) {
+            recorder_->recordSync(result.eventTimeNs);
+        }
+        return true;
+    }
+
+private:
+    SimScript &script_;
+    const Clock &clock_;
+    int64_t startNs_;
+};
+
+JoystickSimulator::JoystickSimulator(const JoystickConfig &config)
+    : clock_(SIM_START_NS),
+      startNs_(SIM_START_NS),
+      script_{{}, 0, true},
+      device_(config, nullptr, &clock_) {
+    device_.open(std::unique_ptr<InputBackend>(new ScriptBackend(script_, clock_, startNs_)));
+}
+
+void JoystickSimulator::axis(int64_t timeNs, int axis, float raw) {
+    script_.inputs.push_back(SimInput{timeNs, RecordInputKind::Axis, static_cast<uint16_t>(axis), raw});
+    script_.sorted = false;
+}
+
+void JoystickSimulator::button(int64_t timeNs, int button, bool pressed) {
+    script_.inputs.push_back(SimInput{timeNs, RecordInputKind::Button, static_cast<uint16_t>(button),
+                                      pressed ? 1.0f : 0.0f});
+    script_.sorted = false;
+}
+
+bool JoystickSimulator::loadRecording(const char *path, std::string *error, JoystickConfig *recordedConfig) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        if (error) {
+            *error = std::string("cannot open ") + path;
+        }
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    RecordFileHeader header;
+    if (data.size() < sizeof(header)) {
+        if (error) {
+            *error = std::string(path) + ": too short";
+        }
+        return false;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, RECORD_MAGIC, sizeof(header.magic)) != 0 || header.version != RECORD_VERSION ||
+        header.headerSize < sizeof(RecordFileHeader) || header.maxAxes != MAX_AXES ||
+        header.maxButtons != MAX_BUTTONS) {
+        if (error) {
+            *error = std::string(path) + ": not a compatible recording";
+        }
+        return false;
+    }
+
+    // Sync 레코드가 올 때까지 입력을 모아 두었다가 그 Sync 시각으로 추가
+    std::vector<SimInput> frame;
+    bool haveFirst = false;
+    int64_t firstTimeNs = 0;
+    size_t pos = header.headerSize;
+    while (pos + sizeof(RecordHeader) <= data.size()) {
+        RecordHeader record;
+        std::memcpy(&record, data.data() + pos, sizeof(record));
+        if (pos + sizeof(record) + record.size > data.size()) {
+            break;  // 녹화 도중 끊겨 잘린 레코드
+        }
+        const char *payload = data.data() + pos + sizeof(record);
+        if (!haveFirst) {
+            firstTimeNs = record.timeNs;
+            haveFirst = true;
+        }
+
+        RecordType type = static_cast<RecordType>(record.type);
+        if (type == RecordType::Config && recordedConfig && record.size == sizeof(JoystickConfig)) {
+            std::memcpy(recordedConfig, payload, sizeof(JoystickConfig));
+        } else if (type == RecordType::Input && record.size == sizeof(RecordInput)) {
+            RecordInput input;
+            std::memcpy(&input, payload, sizeof(input));
+            frame.push_back(SimInput{0, static_cast<RecordInputKind>(input.kind), input.index, input.value});
+        } else if (type == RecordType::Sync) {
+            for (SimInput &input : frame) {
+                input.timeNs = record.timeNs - firstTimeNs;
+                script_.inputs.push_back(input);
+            }
+            frame.clear();
+        }
+        pos += sizeof(record) + record.size;
+    }
+    script_.sorted = false;
+    return true;
+}
+
+uint64_t JoystickSimulator::run(int64_t durationNs, const std::function<void(const JoystickState &)> &onTick) {
+    if (!script_.sorted) {
+        // 이미 반영한 입력은 그대로 두고 나머지만 시각 순으로 (같은 시각이면 추가한 순서)
+        std::stable_sort(script_.inputs.begin() + script_.next, script_.inputs.end(),
+                         [](const SimInput &a, const SimInput &b) { return a.timeNs < b.timeNs; });
+        script_.sorted = true;
+    }
+
+    uint64_t ticks = 0;
+    int64_t endNs = clock_.nowNs() + durationNs;
+    while (clock_.nowNs() < endNs) {
+        // JoystickManager의 폴링 루프와 같은 순서: 큐 비우기 → 틱 → 다음 주기
+        long long loopNs = 1000000000LL / device_.loopHz();
+        device_.readPendingEvents();
+        device_.tick(loopNs / 1000000000.0f);
+        if (onTick) {
+            onTick(device_.getState());
+        }
+        clock_.advance(loopNs);
+        ++ticks;
+    }
+    return ticks;
+}
+
+int64_t JoystickSimulator::nowNs() const {
+    return clock_.nowNs() - startNs_;
+}
+
+JoystickDevice &JoystickSimulator::device() {
+    return device_;
+}
+
+JoystickState JoystickSimulator::state() const {
+    return device_.getState();
+}
+
+}  // namespace joy
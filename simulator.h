@@ -0,0 +1,83 @@
+#ifndef JOYSTICK_SIMULATOR_H
+#define JOYSTICK_SIMULATOR_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "clock.h"
+#include "joystick.h"
+#include "recorder.h"
+
+namespace joy {
+
+// 시뮬레이션 입력 하나 (시각은 시뮬레이션 시작 기준 ns)
+struct SimInput {
+    int64_t         timeNs;
+    RecordInputKind kind;
+    uint16_t        index;   // 축/버튼 인덱스
+    float           value;   // 축: raw 값 (±32767), 버튼: 0/1
+};
+
+// 스크립트 백엔드와 시뮬레이터가 공유하는 입력 목록
+struct SimScript {
+    std::vector<SimInput> inputs;
+    size_t next;             // 다음에 반영할 입력
+    bool   sorted;
+};
+
+/**
+ * @brief JoystickSimulator
+ *
+ * 장치 없이 JoystickDevice 하나를 ManualClock으로 돌리는 헤드리스 시뮬레이터.
+ * 실제 작업 스레드와 똑같이 매 주기 readPendingEvents → tick(초기화 게이팅, Kill Switch,
+ * updateAccumulators, updateSharedState, 발행)을 실행하지만 sleep 없이 시계만 전진시키므로
+ * 몇 시간 분량의 입력을 몇 초 안에 돌릴 수 있습니다. (튜닝 스윕, 회귀 비교용)
+ *
+ * 사용 예:
+ *   JoystickSimulator sim(config);
+ *   sim.button(0, config.buttonStart, true);
+ *   sim.axis(3000000000LL, 1, -32767.0f);
+ *   sim.run(10000000000LL, [](const JoystickState &s) { ... });
+ */
+class JoystickSimulator {
+public:
+    explicit JoystickSimulator(const JoystickConfig &config);
+
+    JoystickSimulator(const JoystickSimulator &) = delete;
+    JoystickSimulator &operator=(const JoystickSimulator &) = delete;
+
+    // 스크립트 입력 추가 (시각 순서와 상관없이 추가 가능)
+    void axis(int64_t timeNs, int axis, float raw);
+    void button(int64_t timeNs, int button, bool pressed);
+
+    /**
+     * @brief 녹화 파일(recorder.h)의 입력을 스크립트로 불러옴
+     *
+     * Sync 레코드 단위로 묶인 입력을 그 Sync 시각에 반영하며, 시각은 첫 레코드 기준으로 옮깁니다.
+     * @param recordedConfig  녹화 당시 설정을 받을 곳 (nullptr이면 무시)
+     */
+    bool loadRecording(const char *path, std::string *error = nullptr, JoystickConfig *recordedConfig = nullptr);
+
+    /**
+     * @brief durationNs 동안 설정의 loopHz 주기로 틱을 실행
+     *
+     * @param onTick  매 틱이 끝난 뒤 발행된 상태로 호출 (nullptr이면 생략)
+     * @return 실행한 틱 수
+     */
+    uint64_t run(int64_t durationNs, const std::function<void(const JoystickState &)> &onTick = nullptr);
+
+    int64_t nowNs() const;                   // 시뮬레이션 시작 기준 현재 시각
+    JoystickDevice &device();
+    JoystickState state() const;             // 최신 발행 상태
+
+private:
+    ManualClock clock_;
+    int64_t startNs_;
+    SimScript script_;
+    JoystickDevice device_;
+};
+
+}  // namespace joy
+#endif // JOYSTICK_SIMULATOR_H